@@ -0,0 +1,187 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include "BigAccumulator.h"
+
+static const int64_t CHUNK_BASE = static_cast<int64_t>(1) << 32;
+
+// floor division by 2^32 that does not rely on the right shift of negative numbers
+static int64_t carry_of(const int64_t value) {
+    return (value - static_cast<int64_t>(static_cast<uint64_t>(value) & 0xFFFFFFFFu)) / CHUNK_BASE;
+}
+
+BigAccumulator::BigAccumulator() :
+        _columns(),
+        _pending(0) {}
+
+void BigAccumulator::reserve_pending(const uint64_t chunks) {
+    if (_pending + chunks > MAX_PENDING)
+        propagate();
+    _pending += chunks;
+}
+
+void BigAccumulator::ensure_columns(const size_t count) {
+    if (_columns.size() < count)
+        _columns.resize(count, 0);
+}
+
+// leaves every column in [0, 2^32), except a final -1 standing for the sign of a negative sum
+void BigAccumulator::propagate() {
+
+    int64_t carry = 0;
+    for (int64_t &column : _columns) {
+        const int64_t value = column + carry;
+        column = static_cast<int64_t>(static_cast<uint64_t>(value) & CHUNK_MASK);
+        carry = carry_of(value);
+    }
+    while (carry != 0 && carry != -1) {
+        _columns.push_back(static_cast<int64_t>(static_cast<uint64_t>(carry) & CHUNK_MASK));
+        carry = carry_of(carry);
+    }
+    if (carry == -1) {
+        _columns.push_back(-1);
+    } else {
+        while (!_columns.empty() && _columns.back() == 0)
+            _columns.pop_back();
+    }
+
+    _pending = 1;
+}
+
+void BigAccumulator::add_signed(const BigInteger &value, const int sign) {
+
+    const long size = value.size();
+    const size_t chunks = static_cast<size_t>(size + 3) / 4;
+
+    reserve_pending(2);
+    ensure_columns(chunks + 1);
+
+    const Byte *first = value.begin();
+    const Byte *last = value.end();
+    for (size_t i = 0; i < chunks; i++) {
+        const Byte *chunk_begin = std::max(first, last - 4);
+        uint64_t chunk = 0;
+        for (const Byte *it = chunk_begin; it < last; it++)
+            chunk = (chunk << 8) | *it;
+        _columns[i] += sign * static_cast<int64_t>(chunk);
+        last = chunk_begin;
+    }
+
+    // the bytes of a negative value read as unsigned are the value plus 2^(8 size)
+    if (value.is_neg()) {
+        const unsigned long bit = static_cast<unsigned long>(size) * BigInteger::BITS_IN_BYTE;
+        _columns[bit / CHUNK_BITS] -= sign * (static_cast<int64_t>(1) << (bit % CHUNK_BITS));
+    }
+}
+
+BigAccumulator &BigAccumulator::add(const BigInteger &value) {
+    add_signed(value, 1);
+    return *this;
+}
+
+BigAccumulator &BigAccumulator::subtract(const BigInteger &value) {
+    add_signed(value, -1);
+    return *this;
+}
+
+vector<uint32_t> BigAccumulator::magnitude_chunks(const BigInteger &value) {
+
+    BigInteger magnitude(value);
+    if (magnitude.is_neg())
+        magnitude.negate();
+
+    vector<uint32_t> chunks;
+    const Byte *first = magnitude.begin();
+    for (const Byte *last = magnitude.end(); last > first; last -= 4) {
+        uint32_t chunk = 0;
+        for (const Byte *it = std::max(first, last - 4); it < last; it++)
+            chunk = (chunk << 8) | *it;
+        chunks.push_back(chunk);
+    }
+    return chunks;
+}
+
+BigAccumulator &BigAccumulator::add_product(const BigInteger &a, const BigInteger &b) {
+
+    vector<uint32_t> x = magnitude_chunks(a);
+    vector<uint32_t> y = magnitude_chunks(b);
+    if (x.size() > y.size())
+        x.swap(y);
+
+    // column k gets the low half of x[i] * y[k - i] and the high half of x[i] * y[k - 1 - i]
+    reserve_pending(2 * x.size());
+    ensure_columns(x.size() + y.size() + 1);
+
+    const bool negative = a.is_neg() != b.is_neg();
+    for (size_t i = 0; i < x.size(); i++) {
+        if (x[i] == 0)
+            continue;
+        int64_t *column = _columns.data() + i;
+        for (size_t j = 0; j < y.size(); j++) {
+            const uint64_t product = static_cast<uint64_t>(x[i]) * y[j];
+            const int64_t low = static_cast<int64_t>(product & CHUNK_MASK);
+            const int64_t high = static_cast<int64_t>(product >> CHUNK_BITS);
+            if (negative) {
+                column[j] -= low;
+                column[j + 1] -= high;
+            } else {
+                column[j] += low;
+                column[j + 1] += high;
+            }
+        }
+    }
+
+    return *this;
+}
+
+BigAccumulator &BigAccumulator::merge(const BigAccumulator &other) {
+
+    if (this == &other) {
+        BigAccumulator copy(other);
+        return merge(copy);
+    }
+
+    reserve_pending(other._pending);
+    ensure_columns(other._columns.size());
+    for (size_t i = 0; i < other._columns.size(); i++)
+        _columns[i] += other._columns[i];
+
+    return *this;
+}
+
+BigInteger BigAccumulator::result() const &{
+
+    BigAccumulator resolved(*this);
+    resolved.propagate();
+
+    const vector<int64_t> &columns = resolved._columns;
+    const bool negative = !columns.empty() && columns.back() == -1;
+    const size_t chunks = columns.size() - (negative ? 1 : 0);
+
+    BigInteger ans;
+    const int size = static_cast<int>(chunks) * 4 + 1;
+    if (size > ans.capacity())
+        ans.reallocate(size);
+    ans._size = size;
+
+    Byte *it = ans.end();
+    for (size_t i = 0; i < chunks; i++) {
+        uint64_t chunk = static_cast<uint64_t>(columns[i]);
+        for (int k = 0; k < 4; k++, chunk >>= 8)
+            *--it = static_cast<Byte>(chunk);
+    }
+    *ans.begin() = negative ? BigInteger::MAX_BYTE : BigInteger::MIN_BYTE;
+    ans._neg = negative;
+    ans.normalize();
+
+    return ans;
+}
+
+void BigAccumulator::clear() {
+    _columns.clear();
+    _pending = 0;
+}
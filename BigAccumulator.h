@@ -0,0 +1,59 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "BigInteger.h"
+
+using std::vector;
+
+
+// Sum of many BigIntegers kept in carry-save form: every value is split into 32-bit
+// chunks added to 64-bit columns without carrying, so an addition never touches
+// more columns than the value has. Carries are resolved only when the columns could
+// overflow, and by result(). Accumulators of different threads can be merged.
+class BigAccumulator {
+
+public:
+
+    BigAccumulator();
+
+    BigAccumulator &add(const BigInteger &);
+
+    BigAccumulator &subtract(const BigInteger &);
+
+    // adds a * b, multiplying chunk by chunk straight into the columns
+    BigAccumulator &add_product(const BigInteger &a, const BigInteger &b);
+
+    BigAccumulator &merge(const BigAccumulator &);
+
+    BigInteger result() const &;
+
+    void clear();
+
+private:
+
+    static const int CHUNK_BITS = 32;
+    static const uint64_t CHUNK_MASK = 0xFFFFFFFFu;
+
+    // each column stays below 2^63 while at most this many chunks were added since propagate()
+    static const uint64_t MAX_PENDING = static_cast<uint64_t>(1) << 30;
+
+    // least significant first, the value is the sum of column[i] * 2^(32 i)
+    vector<int64_t> _columns;
+    uint64_t _pending;
+
+    void reserve_pending(uint64_t);
+
+    void ensure_columns(size_t);
+
+    void propagate();
+
+    void add_signed(const BigInteger &, int sign);
+
+    static vector<uint32_t> magnitude_chunks(const BigInteger &);
+};
@@ -0,0 +1,272 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <cstdlib>
+#include "BigDecimal.h"
+#include "BigIntegerPowerCache.h"
+
+static uint64_t word_power_of_ten(const uint32_t exponent) {
+    uint64_t power = 1;
+    for (uint32_t i = 0; i < exponent; i++)
+        power *= 10;
+    return power;
+}
+
+// whether a quotient rounded down, leaving a non-zero remainder, is to be rounded up instead;
+// half is the sign of comparing that remainder with half of the divisor, negative tells
+// whether the exact quotient is below zero, odd whether the rounded down one is odd
+static bool rounds_up(const BigDecimal::Rounding rounding, const int half, const bool negative, const bool odd) {
+    switch (rounding) {
+        case BigDecimal::Rounding::FLOOR:
+            return false;
+        case BigDecimal::Rounding::CEILING:
+            return true;
+        case BigDecimal::Rounding::HALF_UP:
+            return half > 0 || (half == 0 && !negative);
+        default:
+            return half > 0 || (half == 0 && odd);
+    }
+}
+
+BigDecimal::BigDecimal(BigInteger unscaled, const int32_t scale) :
+        _unscaled(std::move(unscaled)),
+        _scale(scale) {}
+
+BigDecimal::BigDecimal(const string &number) :
+        _unscaled(),
+        _scale(0) {
+
+    if (number.empty())
+        throw BigInteger::BigIntegerException("Empty string parameter");
+
+    string digits;
+    digits.reserve(number.size());
+    bool point = false;
+    for (size_t i = 0; i < number.size(); i++) {
+        const char c = number[i];
+        if (c == '-' && i == 0) {
+            digits.push_back(c);
+        } else if (c == '.' && !point) {
+            point = true;
+        } else if (c >= '0' && c <= '9') {
+            digits.push_back(c);
+            if (point)
+                _scale++;
+        } else {
+            throw BigInteger::BigIntegerException("Illegal string parameter");
+        }
+    }
+    if (digits.empty() || digits == "-")
+        throw BigInteger::BigIntegerException("Illegal string parameter");
+
+    _unscaled = BigInteger(digits);
+}
+
+string BigDecimal::to_string() const &{
+
+    const string digits = _unscaled.to_string();
+    const bool negative = digits[0] == '-';
+    const size_t first = negative ? 1 : 0;
+    const size_t length = digits.size() - first;
+
+    if (_scale <= 0) {
+        if (_unscaled == BigInteger::ZERO)
+            return digits;
+        string ans;
+        ans.reserve(digits.size() + static_cast<size_t>(-static_cast<int64_t>(_scale)));
+        ans += digits;
+        ans.append(static_cast<size_t>(-static_cast<int64_t>(_scale)), '0');
+        return ans;
+    }
+
+    const size_t scale = static_cast<size_t>(_scale);
+    string ans;
+    ans.reserve(digits.size() + scale + 2);
+    if (negative)
+        ans.push_back('-');
+    if (length > scale) {
+        ans.append(digits, first, length - scale);
+        ans.push_back('.');
+        ans.append(digits, digits.size() - scale, scale);
+    } else {
+        ans += "0.";
+        ans.append(scale - length, '0');
+        ans.append(digits, first, length);
+    }
+
+    return ans;
+}
+
+void BigDecimal::multiply_by_power_of_ten(BigInteger &value, const uint32_t exponent) {
+    if (exponent <= BigInteger::DIGITS_IN_WORD)
+        value *= word_power_of_ten(exponent);
+    else
+        value *= BigIntegerPowerCache::power_of_ten(exponent);
+}
+
+BigInteger BigDecimal::divide_rounded(BigInteger numerator, BigInteger denominator, const Rounding rounding) {
+
+    if (denominator.is_neg()) {
+        numerator.negate();
+        denominator.negate();
+    }
+
+    // |numerator| / denominator rounded down, with the remainder from the same division
+    const bool negative = numerator.is_neg();
+    BigInteger remainder;
+    BigInteger quotient = BigInteger::divide_positive(numerator, denominator, remainder);
+    if (negative)
+        quotient.negate();
+    if (remainder.is_zero())
+        return quotient;
+
+    // rounded down toward minus infinity, a negative quotient leaves denominator - remainder,
+    // which compares to half of the denominator the other way round
+    int half = BigInteger::compare(remainder << 1, denominator);
+    if (negative) {
+        quotient -= 1;
+        half = -half;
+    }
+    if (rounds_up(rounding, half, negative, quotient.test_bit(0)))
+        quotient += 1;
+
+    return quotient;
+}
+
+BigDecimal &BigDecimal::set_scale(const int32_t scale, const Rounding rounding) &{
+
+    if (scale >= _scale) {
+        multiply_by_power_of_ten(_unscaled, static_cast<uint32_t>(static_cast<int64_t>(scale) - _scale));
+        _scale = scale;
+        return *this;
+    }
+
+    const uint32_t exponent = static_cast<uint32_t>(static_cast<int64_t>(_scale) - scale);
+    if (exponent <= BigInteger::DIGITS_IN_WORD) {
+        // one word division and one word remainder
+        const uint64_t divisor = word_power_of_ten(exponent);
+        const uint64_t remainder = _unscaled.remainder(divisor);
+        const bool negative = _unscaled.is_neg();
+        _unscaled /= divisor;
+        if (remainder != 0) {
+            const int half = remainder > divisor - remainder ? 1 : remainder == divisor - remainder ? 0 : -1;
+            if (rounds_up(rounding, half, negative, _unscaled.test_bit(0)))
+                _unscaled += 1;
+        }
+    } else {
+        _unscaled = divide_rounded(std::move(_unscaled), BigIntegerPowerCache::power_of_ten(exponent), rounding);
+    }
+    _scale = scale;
+
+    return *this;
+}
+
+BigDecimal &BigDecimal::negate() &{
+    _unscaled.negate();
+    return *this;
+}
+
+BigDecimal &BigDecimal::operator+=(const BigDecimal &b) &{
+
+    if (_scale < b._scale)
+        set_scale(b._scale);
+
+    if (b._scale < _scale) {
+        BigInteger aligned(b._unscaled);
+        multiply_by_power_of_ten(aligned, static_cast<uint32_t>(static_cast<int64_t>(_scale) - b._scale));
+        _unscaled += aligned;
+    } else {
+        _unscaled += b._unscaled;
+    }
+
+    return *this;
+}
+
+BigDecimal &BigDecimal::operator-=(const BigDecimal &b) &{
+    return (*this) += -b;
+}
+
+BigDecimal &BigDecimal::operator*=(const BigDecimal &b) &{
+    _unscaled *= b._unscaled;
+    _scale += b._scale;
+    return *this;
+}
+
+BigDecimal &BigDecimal::divide(const BigDecimal &b, const int32_t scale, const Rounding rounding) &{
+
+    if (b._unscaled == BigInteger::ZERO)
+        throw BigInteger::BigIntegerException("Division by zero");
+
+    // a 10^-sa / (b 10^-sb) = a / b 10^(sb - sa), scaled by 10^scale
+    const int64_t exponent = static_cast<int64_t>(scale) - _scale + b._scale;
+    BigInteger numerator(_unscaled), denominator(b._unscaled);
+    if (exponent >= 0)
+        multiply_by_power_of_ten(numerator, static_cast<uint32_t>(exponent));
+    else
+        multiply_by_power_of_ten(denominator, static_cast<uint32_t>(-exponent));
+
+    _unscaled = divide_rounded(std::move(numerator), std::move(denominator), rounding);
+    _scale = scale;
+
+    return *this;
+}
+
+int BigDecimal::compare(const BigDecimal &a, const BigDecimal &b) {
+
+    if (a._scale == b._scale)
+        return BigInteger::compare(a._unscaled, b._unscaled);
+    if (a._unscaled.is_neg() != b._unscaled.is_neg())
+        return a._unscaled.is_neg() ? -1 : 1;
+
+    BigInteger aligned(a._scale < b._scale ? a._unscaled : b._unscaled);
+    multiply_by_power_of_ten(aligned, static_cast<uint32_t>(std::abs(static_cast<int64_t>(a._scale) - b._scale)));
+    return a._scale < b._scale ? BigInteger::compare(aligned, b._unscaled) : BigInteger::compare(a._unscaled, aligned);
+}
+
+ostream &operator<<(ostream &os, const BigDecimal &number) {
+    os << number.to_string();
+    return os;
+}
+
+BigDecimal operator+(BigDecimal a, const BigDecimal &b) {
+    return a += b;
+}
+
+BigDecimal operator-(BigDecimal a, const BigDecimal &b) {
+    return a -= b;
+}
+
+BigDecimal operator*(BigDecimal a, const BigDecimal &b) {
+    return a *= b;
+}
+
+BigDecimal operator-(BigDecimal a) {
+    return a.negate();
+}
+
+bool operator==(const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) == 0;
+}
+
+bool operator!=(const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) != 0;
+}
+
+bool operator<=(const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) <= 0;
+}
+
+bool operator>=(const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) >= 0;
+}
+
+bool operator<(const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) < 0;
+}
+
+bool operator>(const BigDecimal &a, const BigDecimal &b) {
+    return BigDecimal::compare(a, b) > 0;
+}
@@ -0,0 +1,90 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "BigInteger.h"
+
+using std::string;
+using std::ostream;
+
+
+// Fixed-point decimal: unscaled * 10^-scale. Rescaling multiplies or divides by one machine
+// word for up to 19 digits, and by the shared powers of BigIntegerPowerCache beyond that.
+class BigDecimal {
+
+public:
+
+    enum class Rounding {
+        HALF_EVEN,
+        HALF_UP,    // ties away from zero
+        FLOOR,
+        CEILING
+    };
+
+    BigDecimal(BigInteger unscaled = BigInteger::ZERO, int32_t scale = 0);
+
+    // "-123.4500" has scale 4
+    explicit BigDecimal(const string &);
+
+    const BigInteger &unscaled() const &{ return _unscaled; }
+
+    int32_t scale() const &{ return _scale; }
+
+    // exactly scale() digits after the point, trailing zeros for a negative scale
+    string to_string() const &;
+
+    BigDecimal &set_scale(int32_t, Rounding = Rounding::HALF_EVEN) &;
+
+    BigDecimal &negate() &;
+
+    BigDecimal &operator+=(const BigDecimal &) &;
+
+    BigDecimal &operator-=(const BigDecimal &) &;
+
+    // the scale of a product is the sum of the scales
+    BigDecimal &operator*=(const BigDecimal &) &;
+
+    // the quotient rounded to the given scale
+    BigDecimal &divide(const BigDecimal &, int32_t scale, Rounding = Rounding::HALF_EVEN) &;
+
+    static int compare(const BigDecimal &, const BigDecimal &);
+
+private:
+
+    BigInteger _unscaled;
+    int32_t _scale;
+
+    static void multiply_by_power_of_ten(BigInteger &, uint32_t);
+
+    // numerator / denominator rounded to an integer
+    static BigInteger divide_rounded(BigInteger numerator, BigInteger denominator, Rounding);
+};
+
+
+ostream &operator<<(ostream &, const BigDecimal &);
+
+BigDecimal operator+(BigDecimal, const BigDecimal &);
+
+BigDecimal operator-(BigDecimal, const BigDecimal &);
+
+BigDecimal operator*(BigDecimal, const BigDecimal &);
+
+BigDecimal operator-(BigDecimal);
+
+bool operator==(const BigDecimal &, const BigDecimal &);
+
+bool operator!=(const BigDecimal &, const BigDecimal &);
+
+bool operator<=(const BigDecimal &, const BigDecimal &);
+
+bool operator>=(const BigDecimal &, const BigDecimal &);
+
+bool operator<(const BigDecimal &, const BigDecimal &);
+
+bool operator>(const BigDecimal &, const BigDecimal &);
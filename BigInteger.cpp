@@ -4,11 +4,23 @@
 //*******************************************//
 
 
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
-#include <stack>
+#include <vector>
 #include "BigInteger.h"
+#include "BigIntegerAsync.h"
+#include "BigIntegerKernels.h"
+#include "BigIntegerPowerCache.h"
+#include "BigIntegerStats.h"
+#include "BigIntegerThresholds.h"
 
-using std::stack;
+using std::vector;
 using std::cout;
 using std::endl;
 
@@ -20,49 +32,135 @@ const Byte BigInteger::BYTES_IN_LONG = sizeof(long);
 const Byte BigInteger::MIN_BYTE = 0;
 const Byte BigInteger::MAX_BYTE = 255;
 const int BigInteger::BYTE = 256;
+const Byte BigInteger::BYTES_IN_WORD = sizeof(uint64_t);
+const int BigInteger::DIGITS_IN_WORD;
+const int BigInteger::TRIM_SLACK;
+
+const BigInteger::GrowthPolicy BigInteger::DEFAULT_GROWTH_POLICY = {100, 400};
+
+// constant-initialized, so usable from static constructors
+static std::atomic<unsigned int> growth_percent(100);
+static std::atomic<unsigned int> trim_percent(400);
+static std::atomic<bool> share_copies(true);
+
+// the header in front of every buffer
+struct Storage {
+    std::atomic<int> references;
+};
+
+static Storage *storage_of(const Byte *bytes) {
+    return reinterpret_cast<Storage *>(const_cast<Byte *>(bytes)) - 1;
+}
+
+static const uint64_t POWERS_OF_TEN[] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+        1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull
+};
+
+static uint64_t load_word(const Byte *bytes, const int length) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (length == 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return __builtin_bswap64(word);
+    }
+#endif
+    uint64_t word = 0;
+    for (int i = 0; i < length; i++)
+        word = (word << 8) | bytes[i];
+    return word;
+}
+
+static void store_word(Byte *bytes, const int length, uint64_t word) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (length == 8) {
+        word = __builtin_bswap64(word);
+        std::memcpy(bytes, &word, sizeof(word));
+        return;
+    }
+#endif
+    for (int i = length - 1; i >= 0; i--, word >>= 8)
+        bytes[i] = static_cast<Byte>(word);
+}
+
+// divides the unsigned bytes [first, last) by d a word at a time, the quotient may overwrite them
+static uint64_t divide_bytes_by_word(const Byte *first, const Byte *last, const uint64_t d, Byte *quotient) {
+
+    const int shift = mpn::leading_zeros(d);
+    const uint64_t normalized = d << shift;
+    const uint64_t v = mpn::reciprocal(normalized);
+
+    uint64_t remainder = 0;
+    int length = static_cast<int>((last - first) % 8 == 0 ? 8 : (last - first) % 8);
+    for (const Byte *it = first; it < last; it += length, length = 8) {
+        const uint64_t word = load_word(it, length);
+        const uint64_t high = shift == 0 ? remainder : (remainder << shift) | (word >> (64 - shift));
+        uint64_t shifted_remainder;
+        const uint64_t q = mpn::divide_words(high, word << shift, normalized, v, shifted_remainder);
+        remainder = shifted_remainder >> shift;
+        if (quotient != nullptr) {
+            store_word(quotient, length, q);
+            quotient += length;
+        }
+    }
+
+    return remainder;
+}
+
+// the unsigned bytes [first, last) as little-endian words, without high zero words but at least one
+static vector<uint64_t> load_words(const Byte *first, const Byte *last) {
+    vector<uint64_t> words;
+    words.reserve(static_cast<size_t>(last - first) / 8 + 1);
+    for (; last - first >= 8; last -= 8)
+        words.push_back(load_word(last - 8, 8));
+    if (last > first || words.empty())
+        words.push_back(load_word(first, static_cast<int>(last - first)));
+    while (words.size() > 1 && words.back() == 0)
+        words.pop_back();
+    return words;
+}
+
+// the two's complement bytes [first, last) sign-extended to count little-endian words
+static void load_twos_complement(const Byte *first, const Byte *last, const Byte filler, uint64_t *words,
+                                 const size_t count) {
+    size_t i = 0;
+    for (; i < count && last - first >= 8; i++, last -= 8)
+        words[i] = load_word(last - 8, 8);
+    const uint64_t fill = filler == 0 ? 0 : ~static_cast<uint64_t>(0);
+    if (i < count && last > first) {
+        const int length = static_cast<int>(last - first);
+        words[i++] = load_word(first, length) | (fill << (8 * length));
+    }
+    std::fill(words + i, words + count, fill);
+}
 
 BigInteger::BigInteger(string number) :
         _neg(false),
-        _size(0),
+        _size(1),
         _capacity(0),
+        _reserved(0),
         _bytes(nullptr) {
 
+    BIGINTEGER_STATS_SCOPE(PARSE, number.size() * 5 / 12 + 1);
+
     if (number.empty())
         throw BigIntegerException("Empty string parameter");
 
     bool negative = false;
+    size_t first = 0;
     if (number[0] == '-') {
-        number[0] = '0';
         negative = true;
+        first = 1;
     }
 
-    for (string::iterator it = number.begin(); it < number.end(); ++it)
+    for (string::iterator it = number.begin() + first; it < number.end(); ++it)
         if (*it < '0' || *it > '9')
             throw BigIntegerException("Illegal string parameter");
 
-    stack<bool> bits = stack<bool>();
-    do
-        bits.push(is_odd(number.back()));
-    while (divide_string_number_by_two(number));
-
-    _capacity = static_cast<int>(bits.size() - 1) / BITS_IN_BYTE + 1;
-    _size = _capacity;
-    _bytes = new Byte[_capacity];
-
-    int curr_byte_length = static_cast<int>(bits.size() - 1) % BITS_IN_BYTE + 1;
-    for (int i = 0; i < _size; i++) {
-        Byte curr_byte = 0;
-        for (int k = 0; k < curr_byte_length; k++) {
-            curr_byte <<= static_cast<Byte>(1);
-            curr_byte += bits.top();
-            bits.pop();
-        }
-        _bytes[i] = curr_byte;
-        curr_byte_length = BITS_IN_BYTE;
-    }
-
-    if (negative)
-        negate();
+    const char *data = number.data();
+    assign_decimal(data + first, data + number.size(), negative);
 }
 
 BigInteger::BigInteger(const long number) noexcept :
@@ -70,7 +168,8 @@ BigInteger::BigInteger(const long number) noexcept :
              (static_cast<unsigned long>(1) << static_cast<Byte>(BYTES_IN_LONG * BITS_IN_BYTE - 1))),
         _size(BYTES_IN_LONG),
         _capacity(BYTES_IN_LONG),
-        _bytes(new Byte[BYTES_IN_LONG]) {
+        _reserved(0),
+        _bytes(allocate(BYTES_IN_LONG)) {
 
     unsigned long n = number;
     for (Byte *it = end() - 1; it >= begin(); it--) {
@@ -81,23 +180,32 @@ BigInteger::BigInteger(const long number) noexcept :
     normalize();
 }
 
+// shares the buffer of a, or allocates just the size of the value; the reservation is not copied
 BigInteger::BigInteger(const BigInteger &a) noexcept :
         _neg(a.is_neg()),
         _size(a.size()),
         _capacity(a.capacity()),
-        _bytes(new Byte[a.capacity()]) {
+        _reserved(0),
+        _bytes(a._bytes) {
 
-    const Byte *a_it = a._bytes;
-    for (Byte *it = _bytes; it < end(); it++, a_it++)
-        *it = *a_it;
+    if (share_copies.load(std::memory_order_relaxed)) {
+        storage_of(_bytes)->references.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _capacity = a.size();
+    _bytes = allocate(_capacity);
+    std::memcpy(_bytes, a.begin(), static_cast<size_t>(size()));
 }
 
 BigInteger::BigInteger(BigInteger &&old) noexcept :
         _neg(old.is_neg()),
         _size(old.size()),
         _capacity(old.capacity()),
+        _reserved(old._reserved),
         _bytes(old._bytes) {
 
+    old._capacity = 0;
     old._bytes = nullptr;
 }
 
@@ -106,15 +214,27 @@ BigInteger &BigInteger::operator=(const BigInteger &a) & noexcept {
     if (this == &a)
         return *this;
 
-    delete[] _bytes;
+    // a reserved buffer is kept for the value to grow in
+    if (_reserved == 0 && share_copies.load(std::memory_order_relaxed)) {
+        storage_of(a._bytes)->references.fetch_add(1, std::memory_order_relaxed);
+        release(_bytes);
+        _neg = a.is_neg();
+        _size = a.size();
+        _capacity = a.capacity();
+        _bytes = a._bytes;
+        return *this;
+    }
+
+    // the buffer is kept if it is not shared, fits and would not be trimmed
     _neg = a.is_neg();
     _size = a.size();
-    _capacity = a.capacity();
-    _bytes = new Byte[_capacity];
+    if (size() > capacity() || oversized() || is_shared()) {
+        release(_bytes);
+        _capacity = std::max(size(), _reserved);
+        _bytes = allocate(_capacity);
+    }
 
-    const Byte *a_it = a._bytes;
-    for (Byte *it = _bytes; it < end(); it++, a_it++)
-        *it = *a_it;
+    std::memcpy(begin(), a.begin(), static_cast<size_t>(size()));
 
     return *this;
 }
@@ -124,81 +244,178 @@ BigInteger &BigInteger::operator=(BigInteger &&old) & noexcept {
     if (&old == this)
         return *this;
 
+    release(_bytes);
     _neg = old.is_neg();
     _size = old.size();
     _capacity = old.capacity();
+    _reserved = old._reserved;
     _bytes = old._bytes;
+    old._capacity = 0;
     old._bytes = nullptr;
 
     return *this;
 }
 
 BigInteger::~BigInteger() {
-    delete[] _bytes;
+    release(_bytes);
 }
 
-void BigInteger::allocate_more() {
+// capacity bytes used by one value, after a Storage header
+Byte *BigInteger::allocate(const int capacity) {
 
-    Byte *new_alloc = new Byte[capacity() * 2];
+    BIGINTEGER_STATS_ALLOCATION(capacity);
 
-    for (int i = 0; i < capacity(); i++)
-        new_alloc[i] = filler();
-    for (int i = capacity(); i < capacity() * 2; i++)
-        new_alloc[i] = _bytes[i - capacity()];
+    Storage *storage = static_cast<Storage *>(::operator new(sizeof(Storage) + static_cast<size_t>(capacity)));
+    new(&storage->references) std::atomic<int>(1);
+    return reinterpret_cast<Byte *>(storage + 1);
+}
 
-    delete[] _bytes;
+// frees the buffer once no value uses it, the last user sees the writes of all others
+void BigInteger::release(Byte *bytes) {
+
+    if (bytes == nullptr)
+        return;
+
+    Storage *storage = storage_of(bytes);
+    if (storage->references.load(std::memory_order_acquire) == 1 ||
+        storage->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        storage->references.~atomic();
+        ::operator delete(storage);
+    }
+}
+
+// sets the value to zero in a buffer of its own of at least the given capacity
+void BigInteger::clear(const int capacity) {
+    if (capacity > _capacity || is_shared()) {
+        release(_bytes);
+        _capacity = std::max(capacity, _reserved);
+        _bytes = allocate(_capacity);
+    }
+    _neg = false;
+    _size = 1;
+    *begin() = MIN_BYTE;
+}
+
+bool BigInteger::is_shared() const &{
+    return _bytes != nullptr && storage_of(_bytes)->references.load(std::memory_order_acquire) != 1;
+}
+
+// copies a shared buffer before the value changes in place, the copy has the size of the value
+// or its reservation
+void BigInteger::detach() {
+    if (is_shared())
+        reallocate(std::max(size(), _reserved));
+}
+
+// moves the value to a buffer of exactly new_capacity bytes, the slack is left undefined
+void BigInteger::reallocate(const int new_capacity) {
+
+    BIGINTEGER_STATS_SCOPE(REALLOCATE, size());
+
+    Byte *new_alloc = allocate(new_capacity);
+
+    std::memcpy(new_alloc + new_capacity - size(), begin(), static_cast<size_t>(size()));
+
+    release(_bytes);
     _bytes = new_alloc;
-    _capacity *= 2;
+    _capacity = new_capacity;
+}
+
+// the capacity a full buffer of the given capacity grows to, at least needed bytes
+static int grown_capacity(const int capacity, const int needed) {
+    const long grown = capacity + static_cast<long>(capacity) * growth_percent.load(std::memory_order_relaxed) / 100;
+    return std::max(needed, static_cast<int>(std::min<long>(std::max<long>(grown, capacity + 1), INT_MAX)));
+}
+
+void BigInteger::allocate_more() {
+    reallocate(grown_capacity(capacity(), capacity() + 1));
+}
+
+void BigInteger::grow(const int new_size) {
+    if (new_size > capacity())
+        reallocate(grown_capacity(capacity(), new_size));
+    else if (is_shared())
+        reallocate(std::max(new_size, _reserved));
+    const int old_size = size();
+    _size = new_size;
+    // bytes before begin() may be left over from a longer value
+    std::memset(begin(), filler(), static_cast<size_t>(size() - old_size));
 }
 
 void BigInteger::push_front(const Byte byte) {
-    _size++;
-    if (_size > _capacity)
+    if (size() == capacity())
         allocate_more();
+    else if (is_shared())
+        reallocate(std::max(size() + 1, _reserved));
+    _size++;
     *begin() = byte;
 }
 
-int BigInteger::first_significant_bit() const {
-    bool significant_bit_val = !is_neg();
-    for (const Byte *it = begin(); it < end(); it++) {
-        for (Byte k = 0; k < BITS_IN_BYTE; k++) {
-            Byte mask = get_one_bit_mask(BITS_IN_BYTE - 1 - k);
-            if (static_cast<bool>((*it) & mask) == significant_bit_val)
-                return static_cast<int>(it - begin()) * BITS_IN_BYTE
-                       + k - static_cast<int>(is_neg());
-        }
-    }
-    return size() * BITS_IN_BYTE - 1;
+bool BigInteger::oversized() const {
+    const unsigned int trim = trim_percent.load(std::memory_order_relaxed);
+    if (trim == 0)
+        return false;
+    const long keep = std::max(static_cast<long>(size()) * trim / 100, static_cast<long>(_reserved));
+    return capacity() > keep + TRIM_SLACK;
 }
 
-void BigInteger::normalize() {
-    int first_byte = first_significant_bit() / BITS_IN_BYTE;
-    _size -= first_byte;
-    if (_size == 1 && *begin() == 0)
-        _neg = false;
+void BigInteger::set_growth_policy(const GrowthPolicy policy) {
+    growth_percent.store(policy.growth_percent, std::memory_order_relaxed);
+    trim_percent.store(policy.trim_percent, std::memory_order_relaxed);
 }
 
-bool BigInteger::divide_string_number_by_two(string &number) {
+BigInteger::GrowthPolicy BigInteger::growth_policy() {
+    return {growth_percent.load(std::memory_order_relaxed), trim_percent.load(std::memory_order_relaxed)};
+}
 
-    int remainder = 0;
-    bool is_zero = true;
+void BigInteger::set_copy_on_write(const bool enabled) {
+    share_copies.store(enabled, std::memory_order_relaxed);
+}
 
-    for (string::iterator it = number.begin(); it < number.end(); ++it) {
-        char curr_digit = *it;
-        *it = '0' + ((curr_digit - '0') / 2 + remainder);
-        if (*it != '0')
-            is_zero = false;
-        remainder = static_cast<int>(is_odd(curr_digit)) * 5;
-    }
+bool BigInteger::copy_on_write() {
+    return share_copies.load(std::memory_order_relaxed);
+}
 
-    return !is_zero;
+void BigInteger::reserve(const unsigned int bits) &{
+    _reserved = static_cast<int>(bits / BITS_IN_BYTE) + 1;
+    if (_reserved > capacity() || is_shared())
+        reallocate(std::max(size(), _reserved));
+}
+
+void BigInteger::shrink_to_fit() &{
+    _reserved = 0;
+    if (capacity() > size())
+        reallocate(size());
+}
+
+// keeps one byte, and for a negative value the byte holding its sign bit; trims the buffer
+// as the growth policy says
+void BigInteger::normalize() {
+    const Byte sign_mask = get_one_bit_mask(BITS_IN_BYTE - 1);
+    if (_neg) {
+        if ((*begin() & sign_mask) == 0)
+            push_front(MAX_BYTE);
+        while (size() > 1 && *begin() == MAX_BYTE && (*(begin() + 1) & sign_mask) != 0)
+            _size--;
+    } else {
+        while (size() > 1 && *begin() == MIN_BYTE)
+            _size--;
+    }
+    if (_size == 1 && *begin() == 0)
+        _neg = false;
+    if (oversized())
+        reallocate(std::max(size(), _reserved));
 }
 
 BigInteger &BigInteger::negate() &{
 
-    if (size() == 1 && *begin() == 0)
+    BIGINTEGER_STATS_SCOPE(NEGATE, size());
+
+    if (is_zero())
         return *this;
 
+    detach();
+
     if (is_neg()) {
         int remainder = -1;
         for (Byte *it = end() - 1; it >= begin(); it--) {
@@ -219,33 +436,37 @@ BigInteger &BigInteger::negate() &{
     }
 
     _neg = !_neg;
+    normalize();
+
     return *this;
 }
 
 string BigInteger::to_string() const &{
 
-    string ans;
+    BIGINTEGER_STATS_SCOPE(TO_STRING, size());
+
     BigInteger curr(*this);
 
     if (_neg)
         curr.negate();
 
-    bool is_zero;
+    BigIntegerCheckpoint checkpoint;
+    vector<uint64_t> chunks;
     do {
-        is_zero = true;
-        unsigned int remainder = 0;
-        for (Byte *it = curr.begin(); it < curr.end(); it++) {
-            remainder = remainder * BYTE + (*it);
-            *it = remainder / 10;
-            if ((*it) > 0)
-                is_zero = false;
-            remainder %= 10;
-        }
-        ans = char('0' + remainder) + ans;
-    } while (!is_zero);
-
-    if (_neg && ans != "0")
-        ans = '-' + ans;
+        checkpoint.step(static_cast<uint64_t>(size() - curr.size()), static_cast<uint64_t>(size()));
+        chunks.push_back(curr.divide_magnitude_by_word(POWERS_OF_TEN[DIGITS_IN_WORD]));
+    } while (!curr.is_zero());
+
+    string ans = _neg ? "-" : "";
+    ans += std::to_string(chunks.back());
+
+    char chunk[DIGITS_IN_WORD + 1];
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        uint64_t value = chunks[i];
+        for (int k = DIGITS_IN_WORD - 1; k >= 0; k--, value /= 10)
+            chunk[k] = static_cast<char>('0' + value % 10);
+        ans.append(chunk, DIGITS_IN_WORD);
+    }
 
     return ans;
 }
@@ -275,36 +496,38 @@ string BigInteger::to_bits_string() const &{
     return ans;
 }
 
-bool BigInteger::is_odd(const char ch) {
-    return (ch - '0') % 2 == 1;
-}
-
 Byte BigInteger::get_one_bit_mask(const Byte byte) {
     return static_cast<Byte>(1) << byte;
 }
 
 BigInteger &BigInteger::operator>>=(const unsigned int shift) &{
 
-    const unsigned int full_bytes = shift / BigInteger::BITS_IN_BYTE;
-    const unsigned int left_bits = shift % BigInteger::BITS_IN_BYTE;
+    BIGINTEGER_STATS_SCOPE(SHIFT_RIGHT, size());
 
-    for (Byte *it = end() - 1; it >= begin(); it--) {
-        if (it - full_bytes < begin())
-            *it = filler();
-        else
-            *it = *(it - full_bytes);
+    const unsigned int full_bytes = shift / BITS_IN_BYTE;
+    const unsigned int left_bits = shift % BITS_IN_BYTE;
+    const Byte fill = filler();
+
+    if (full_bytes >= static_cast<unsigned int>(size())) {
+        _size = 1;
+        detach();
+        *begin() = fill;
+        normalize();
+        return *this;
     }
 
-    Byte remainder_mask = 0;
-    for (unsigned int i = 0; i < left_bits; i++)
-        remainder_mask = (remainder_mask << static_cast<Byte>(1)) + 1;
-    Byte remainder = filler() & remainder_mask;
+    detach();
+
+    if (full_bytes > 0) {
+        std::memmove(begin() + full_bytes, begin(), size() - full_bytes);
+        _size -= static_cast<int>(full_bytes);
+    }
 
-    for (Byte *it = begin(); it < end(); it++) {
-        Byte next_remainder = (*it) & remainder_mask;
-        (*it) >>= left_bits;
-        (*it) |= static_cast<Byte>(remainder << (BigInteger::BITS_IN_BYTE - left_bits));
-        remainder = next_remainder;
+    // one funnel shift pass, each byte takes its high bits from the more significant neighbour
+    if (left_bits > 0) {
+        for (Byte *it = end() - 1; it > begin(); it--)
+            *it = static_cast<Byte>((*it >> left_bits) | (*(it - 1) << (BITS_IN_BYTE - left_bits)));
+        *begin() = static_cast<Byte>((*begin() >> left_bits) | (fill << (BITS_IN_BYTE - left_bits)));
     }
 
     normalize();
@@ -314,47 +537,64 @@ BigInteger &BigInteger::operator>>=(const unsigned int shift) &{
 
 BigInteger &BigInteger::operator<<=(const unsigned int shift) &{
 
-    const int new_greatest_bit = first_significant_bit() - static_cast<int>(shift);
-    if (new_greatest_bit < 0) {
-        _size += (-new_greatest_bit - 1) / BITS_IN_BYTE + 1;
-        while (size() > capacity())
-            allocate_more();
-    }
+    BIGINTEGER_STATS_SCOPE(SHIFT_LEFT, size());
 
-    const unsigned int full_bytes = shift / BigInteger::BITS_IN_BYTE;
-    const unsigned int left_bits = shift % BigInteger::BITS_IN_BYTE;
+    if (is_zero())
+        return *this;
 
-    for (Byte *it = begin(); it < end(); it++) {
-        if (it + full_bytes >= end())
-            *it = BigInteger::MIN_BYTE;
-        else
-            *it = *(it + full_bytes);
+    const unsigned int full_bytes = shift / BITS_IN_BYTE;
+    const unsigned int left_bits = shift % BITS_IN_BYTE;
+    const Byte fill = filler();
+
+    // room for every significant bit and the sign, allocated once
+    const int old_size = size();
+    const int new_size = std::max(static_cast<int>((bit_length() + shift) / BITS_IN_BYTE) + 1,
+                                  old_size + static_cast<int>(full_bytes));
+    if (new_size > capacity() || is_shared())
+        reallocate(std::max(new_size, _reserved));
+    _size = new_size;
+
+    Byte *old_begin = end() - old_size;
+    if (full_bytes > 0) {
+        std::memmove(old_begin - full_bytes, old_begin, static_cast<size_t>(old_size));
+        std::memset(end() - full_bytes, MIN_BYTE, full_bytes);
     }
-
-    Byte remainder_mask = 0;
-    for (unsigned int i = 0; i < left_bits; i++)
-        remainder_mask = (remainder_mask << static_cast<Byte>(1)) + 1;
-    remainder_mask <<= (BigInteger::BITS_IN_BYTE - left_bits);
-    Byte remainder = BigInteger::MIN_BYTE & remainder_mask;
-
-    for (Byte *it = end() - 1; it >= begin(); it--) {
-        Byte next_remainder = (*it) & remainder_mask;
-        (*it) <<= left_bits;
-        (*it) |= static_cast<Byte>(remainder >> (BigInteger::BITS_IN_BYTE - left_bits));
-        remainder = next_remainder;
+    std::memset(begin(), fill, static_cast<size_t>(old_begin - full_bytes - begin()));
+
+    // one funnel shift pass, each byte takes its low bits from the less significant neighbour
+    if (left_bits > 0) {
+        Byte *last = end() - full_bytes - 1;
+        for (Byte *it = begin(); it < last; it++)
+            *it = static_cast<Byte>((*it << left_bits) | (*(it + 1) >> (BITS_IN_BYTE - left_bits)));
+        *last = static_cast<Byte>(*last << left_bits);
     }
 
+    normalize();
+
     return (*this);
 }
 
 BigInteger &BigInteger::operator+=(const BigInteger &b) &{
 
-    if (size() < b.size()) {
-        _size = b.size();
-        while (size() > capacity())
-            allocate_more();
+    BIGINTEGER_STATS_SCOPE(ADD, std::max(size(), b.size()));
+
+    const size_t add_limbs = BigIntegerThresholds::get(BigIntegerThresholds::ADD_LIMBS);
+    if (static_cast<size_t>(std::max(size(), b.size())) >= add_limbs * BYTES_IN_WORD) {
+        // two's complement words with a spare one, where the carry ends up as the sign
+        const size_t count = static_cast<size_t>(std::max(size(), b.size())) / BYTES_IN_WORD + 1;
+        vector<uint64_t> words(2 * count);
+        load_twos_complement(begin(), end(), filler(), words.data(), count);
+        load_twos_complement(b.begin(), b.end(), b.filler(), words.data() + count, count);
+        mpn::add_n(words.data(), words.data(), words.data() + count, count);
+        assign_twos_complement(words.data(), count);
+        return *this;
     }
 
+    if (size() < b.size())
+        grow(b.size());
+    else
+        detach();
+
     int remainder = 0;
     const Byte *b_it = b.end() - 1;
     for (Byte *it = end() - 1; it >= begin(); it--, b_it--) {
@@ -387,6 +627,7 @@ BigInteger &BigInteger::operator+=(const BigInteger &b) &{
 }
 
 BigInteger &BigInteger::operator-=(BigInteger b) &{
+    BIGINTEGER_STATS_SCOPE(SUB, std::max(size(), b.size()));
     b.negate();
     (*this) += b;
     return *this;
@@ -394,32 +635,370 @@ BigInteger &BigInteger::operator-=(BigInteger b) &{
 
 BigInteger &BigInteger::operator*=(const BigInteger &b) &{
 
-    if (this == &b)
-        return (*this) *= BigInteger(b);
+    BIGINTEGER_STATS_SCOPE(MUL, size() + b.size());
 
-    if (b.is_neg()) {
-        (*this) *= -b;
-        return (*this).negate();
+    vector<uint64_t> x = magnitude_words(*this);
+    if (&b == this) {
+        vector<uint64_t> product(2 * x.size()), scratch(mpn::mul_scratch_size(x.size()));
+        mpn::sqr(product.data(), x.data(), x.size(), scratch.data());
+        assign_words(product.data(), product.size(), false);
+        return *this;
     }
 
-    bool negative = false;
+    vector<uint64_t> y = magnitude_words(b);
+    if (x.size() < y.size())
+        x.swap(y);
 
-    if (is_neg()) {
-        negative = true;
-        negate();
+    vector<uint64_t> product(x.size() + y.size()), scratch(mpn::mul_scratch_size(x.size()));
+    mpn::mul(product.data(), x.data(), x.size(), y.data(), y.size(), scratch.data());
+    assign_words(product.data(), product.size(), is_neg() != b.is_neg());
+
+    return *this;
+}
+
+BigInteger &BigInteger::operator/=(const BigInteger &b) &{
+
+    BIGINTEGER_STATS_SCOPE(DIV, size());
+
+    if (b.is_zero())
+        throw BigIntegerException("Division by zero");
+
+    BigInteger remainder;
+    BigInteger quotient = divide_positive(*this, b, remainder);
+    if (is_neg() && !remainder.is_zero())
+        quotient.add_word(1, false);
+    if (is_neg() != b.is_neg())
+        quotient.negate();
+
+    return (*this) = std::move(quotient);
+}
+
+static unsigned int popcount_word(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+    unsigned int count = 0;
+    for (; word != 0; word &= word - 1)
+        count++;
+    return count;
+#endif
+}
+
+static unsigned int trailing_zeros_word(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+    unsigned int count = 0;
+    for (; (word & 1u) == 0; word >>= 1)
+        count++;
+    return count;
+#endif
+}
+
+// combines 8 bytes at a time, bitwise operations do not care about the byte order
+template<typename Operation>
+BigInteger &BigInteger::apply_bitwise(const BigInteger &b, Operation operation) {
+
+    BIGINTEGER_STATS_SCOPE(BITWISE, std::max(size(), b.size()));
+
+    const bool negative = operation(filler(), b.filler()) != 0;
+
+    if (size() < b.size())
+        grow(b.size());
+    else
+        detach();
+
+    Byte *it = end() - b.size();
+    const Byte *b_it = b.begin();
+    for (int n = b.size(); n > 0;) {
+        if (n >= 8) {
+            uint64_t x, y;
+            std::memcpy(&x, it, 8);
+            std::memcpy(&y, b_it, 8);
+            x = operation(x, y);
+            std::memcpy(it, &x, 8);
+            it += 8, b_it += 8, n -= 8;
+        } else {
+            *it = static_cast<Byte>(operation(*it, *b_it));
+            it++, b_it++, n--;
+        }
+    }
+
+    const Byte b_filler = b.filler();
+    const uint64_t b_filler_word = b_filler == MAX_BYTE ? ~static_cast<uint64_t>(0) : 0;
+    it = begin();
+    for (int n = size() - b.size(); n > 0;) {
+        if (n >= 8) {
+            uint64_t x;
+            std::memcpy(&x, it, 8);
+            x = operation(x, b_filler_word);
+            std::memcpy(it, &x, 8);
+            it += 8, n -= 8;
+        } else {
+            *it = static_cast<Byte>(operation(*it, b_filler));
+            it++, n--;
+        }
+    }
+
+    _neg = negative;
+    normalize();
+
+    return *this;
+}
+
+BigInteger &BigInteger::operator&=(const BigInteger &b) &{
+    return apply_bitwise(b, [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+BigInteger &BigInteger::operator|=(const BigInteger &b) &{
+    return apply_bitwise(b, [](uint64_t x, uint64_t y) { return x | y; });
+}
+
+BigInteger &BigInteger::operator^=(const BigInteger &b) &{
+    return apply_bitwise(b, [](uint64_t x, uint64_t y) { return x ^ y; });
+}
+
+BigInteger &BigInteger::invert() &{
+
+    BIGINTEGER_STATS_SCOPE(BITWISE, size());
+
+    detach();
+    for (Byte *it = begin(); it < end(); it++)
+        *it = static_cast<Byte>(~(*it));
+    _neg = !_neg;
+    normalize();
+
+    return *this;
+}
+
+bool BigInteger::test_bit(const unsigned int bit) const &{
+    if (bit / BITS_IN_BYTE >= static_cast<unsigned int>(size()))
+        return is_neg();
+    return (*(end() - 1 - bit / BITS_IN_BYTE) & get_one_bit_mask(bit % BITS_IN_BYTE)) != 0;
+}
+
+BigInteger &BigInteger::set_bit(const unsigned int bit, const bool value) &{
+
+    if (test_bit(bit) == value)
+        return *this;
+
+    // one more byte, so the sign stays outside of the changed one
+    if (bit / BITS_IN_BYTE + 1 >= static_cast<unsigned int>(size()))
+        grow(static_cast<int>(bit / BITS_IN_BYTE) + 2);
+    else
+        detach();
+
+    *(end() - 1 - bit / BITS_IN_BYTE) ^= get_one_bit_mask(bit % BITS_IN_BYTE);
+    normalize();
+
+    return *this;
+}
+
+unsigned int BigInteger::popcount() const &{
+
+    const Byte fill = filler();
+    const uint64_t fill_word = fill == MAX_BYTE ? ~static_cast<uint64_t>(0) : 0;
+
+    unsigned int count = 0;
+    const Byte *it = begin();
+    for (; end() - it >= 8; it += 8) {
+        uint64_t x;
+        std::memcpy(&x, it, 8);
+        count += popcount_word(x ^ fill_word);
     }
+    for (; it < end(); it++)
+        count += popcount_word(static_cast<Byte>(*it ^ fill));
 
-    BigInteger shiftedX(*this);
-    (*this) -= *this;
+    return count;
+}
 
-    for (const Byte *b_it = b.end() - 1; b_it >= b.begin(); b_it--) {
-        for (Byte k = 0; k < BITS_IN_BYTE; k++) {
-            Byte mask = get_one_bit_mask(k);
-            if ((*b_it & mask) != 0)
-                (*this) += shiftedX;
-            shiftedX <<= 1;
+unsigned int BigInteger::bit_length() const &{
+    const Byte fill = filler();
+    for (const Byte *it = begin(); it < end(); it++) {
+        const Byte significant = static_cast<Byte>(*it ^ fill);
+        if (significant != 0) {
+            const unsigned int bits = 64 - static_cast<unsigned int>(mpn::leading_zeros(significant));
+            return static_cast<unsigned int>(end() - 1 - it) * BITS_IN_BYTE + bits;
         }
     }
+    return 0;
+}
+
+int BigInteger::trailing_zeros() const &{
+
+    const Byte *it = end();
+    while (it - begin() >= 8) {
+        uint64_t x;
+        std::memcpy(&x, it - 8, 8);
+        if (x != 0)
+            break;
+        it -= 8;
+    }
+
+    for (it--; it >= begin(); it--)
+        if (*it != 0)
+            return static_cast<int>(end() - 1 - it) * BITS_IN_BYTE + static_cast<int>(trailing_zeros_word(*it));
+
+    return -1;
+}
+
+uint64_t BigInteger::magnitude_bits() const {
+    const unsigned int bits = bit_length();
+    // -2^k takes k bits besides the sign, its absolute value k + 1
+    if (is_neg() && trailing_zeros() == static_cast<int>(bits))
+        return static_cast<uint64_t>(bits) + 1;
+    return bits;
+}
+
+uint64_t BigInteger::bits_at(const uint64_t bit) const {
+    const uint64_t first = bit / BITS_IN_BYTE;
+    const unsigned int shift = static_cast<unsigned int>(bit % BITS_IN_BYTE);
+    const auto byte_at = [this](const uint64_t index) -> uint64_t {
+        return index < static_cast<uint64_t>(size()) ? *(end() - 1 - index) : filler();
+    };
+
+    uint64_t word = 0;
+    for (uint64_t index = first + BYTES_IN_WORD; index-- > first;)
+        word = (word << BITS_IN_BYTE) | byte_at(index);
+    if (shift == 0)
+        return word;
+    return (word >> shift) | (byte_at(first + BYTES_IN_WORD) << (64 - shift));
+}
+
+uint64_t BigInteger::magnitude_top(uint64_t &shift, bool &inexact) const {
+
+    const uint64_t bits = magnitude_bits();
+    if (bits <= 64) {
+        shift = 0;
+        inexact = false;
+        return is_neg() ? 0 - bits_at(0) : bits_at(0);
+    }
+
+    shift = bits - 64;
+    inexact = static_cast<uint64_t>(trailing_zeros()) < shift;
+    // -x = ~x + 1, where the 1 reaches the top bits only through zeros of x below them
+    const uint64_t top = bits_at(shift);
+    return is_neg() ? ~top + (inexact ? 0 : 1) : top;
+}
+
+size_t BigInteger::digits10_estimate() const &{
+    return is_zero() ? 1 : static_cast<size_t>(std::floor(log10())) + 1;
+}
+
+double BigInteger::log2() const &{
+    uint64_t shift;
+    bool inexact;
+    const uint64_t top = magnitude_top(shift, inexact);
+    return std::log2(static_cast<double>(top)) + static_cast<double>(shift);
+}
+
+double BigInteger::log10() const &{
+    return log2() * 0.30102999566398119521;
+}
+
+// the lowest of the top 64 bits stands for all dropped ones, so the conversion of the word
+// rounds as the whole value would; scaling by a power of two is then exact, up to infinity
+double BigInteger::to_double() const &{
+    uint64_t shift;
+    bool inexact;
+    const uint64_t top = magnitude_top(shift, inexact);
+    const double magnitude = std::ldexp(static_cast<double>(top | (inexact ? 1 : 0)),
+                                        static_cast<int>(std::min<uint64_t>(shift, 2 * DBL_MAX_EXP)));
+    return is_neg() ? -magnitude : magnitude;
+}
+
+BigInteger BigInteger::from_double(const double value) {
+
+    if (!std::isfinite(value))
+        throw BigIntegerException("Not a finite number");
+
+    // the integer part is m 2^exponent with m below 2^53
+    int exponent;
+    const double fraction = std::frexp(std::trunc(std::fabs(value)), &exponent);
+    const uint64_t m = static_cast<uint64_t>(std::ldexp(fraction, DBL_MANT_DIG));
+    exponent -= DBL_MANT_DIG;
+
+    BigInteger ans;
+    ans += m;
+    if (exponent > 0)
+        ans <<= static_cast<unsigned int>(exponent);
+    else
+        ans >>= static_cast<unsigned int>(-exponent);
+    if (value < 0)
+        ans.negate();
+    return ans;
+}
+
+// adds a word sign-extended by negative; stops as soon as the carry can no longer change a byte
+BigInteger &BigInteger::add_word(const uint64_t word, const bool negative) {
+
+    BIGINTEGER_STATS_SCOPE(ADD, size());
+
+    if (size() < BYTES_IN_WORD)
+        grow(BYTES_IN_WORD);
+    else
+        detach();
+
+    const Byte word_filler = negative ? MAX_BYTE : MIN_BYTE;
+    const unsigned int stable_carry = negative ? 1 : 0;
+
+    unsigned int carry = 0;
+    uint64_t rest = word;
+    Byte *it = end() - 1;
+    for (int i = 0; i < BYTES_IN_WORD; i++, it--, rest >>= 8) {
+        carry += *it + static_cast<unsigned int>(rest & MAX_BYTE);
+        *it = static_cast<Byte>(carry);
+        carry >>= 8;
+    }
+    for (; it >= begin() && carry != stable_carry; it--) {
+        carry += *it + word_filler;
+        *it = static_cast<Byte>(carry);
+        carry >>= 8;
+    }
+    // the byte above the top one decides the sign, and is kept if it is not a plain sign byte
+    const Byte top = static_cast<Byte>(filler() + word_filler + carry);
+    if (top == MIN_BYTE || top == MAX_BYTE) {
+        _neg = top == MAX_BYTE;
+    } else {
+        _neg = top > MAX_BYTE / 2;
+        push_front(top);
+    }
+
+    normalize();
+
+    return *this;
+}
+
+// multiplies the two's complement bytes by a word, with room for the whole product
+BigInteger &BigInteger::multiply_word(const uint64_t word, const bool negative) {
+
+    BIGINTEGER_STATS_SCOPE(MUL, size() + BYTES_IN_WORD);
+
+    if (word == 0 || is_zero()) {
+        _size = 1;
+        detach();
+        *begin() = MIN_BYTE;
+        _neg = false;
+        return *this;
+    }
+
+    if (word != 1) {
+        grow(size() + BYTES_IN_WORD + 1);
+
+        uint64_t carry = 0;
+        int length = BYTES_IN_WORD;
+        for (Byte *it = end(); it > begin(); it -= length) {
+            length = static_cast<int>(std::min<long>(BYTES_IN_WORD, it - begin()));
+            uint64_t high, low;
+            mpn::mul_words(load_word(it - length, length), word, high, low);
+            low += carry;
+            carry = high + (low < carry ? 1 : 0);
+            store_word(it - length, length, low);
+        }
+
+        _neg = (*begin() & get_one_bit_mask(BITS_IN_BYTE - 1)) != 0;
+        normalize();
+    }
 
     if (negative)
         negate();
@@ -427,34 +1006,52 @@ BigInteger &BigInteger::operator*=(const BigInteger &b) &{
     return *this;
 }
 
-BigInteger &BigInteger::operator/=(const BigInteger &b) &{
+uint64_t BigInteger::divide_magnitude_by_word(const uint64_t word) {
+    detach();
+    const uint64_t remainder = divide_bytes_by_word(begin(), end(), word, begin());
+    normalize();
+    return remainder;
+}
 
-    if (this == &b)
-        return (*this) /= BigInteger(b);
+// rounds like operator/=, the remainder stays in [0, word)
+BigInteger &BigInteger::divide_word(const uint64_t word, const bool negative) {
 
-    if (b.size() == 1 && *b.begin() == 0)
-        throw BigIntegerException("Division by zero");
+    BIGINTEGER_STATS_SCOPE(DIV, size());
 
-    if (b.is_neg()) {
-        (*this) /= -b;
-        return (*this).negate();
-    }
+    if (word == 0)
+        throw BigIntegerException("Division by zero");
 
     if (is_neg()) {
         negate();
-        BigInteger ans = divide_positive(*this, b);
-        if (ans * b < *this)
-            ++ans;
-        (*this) = ans;
-        (*this).negate();
+        if (divide_magnitude_by_word(word) != 0)
+            add_word(1, false);
+        negate();
     } else {
-        (*this) = divide_positive(*this, b);
+        divide_magnitude_by_word(word);
     }
 
+    if (negative)
+        negate();
+
     return *this;
 }
 
+uint64_t BigInteger::remainder(const uint64_t word) const &{
+
+    if (word == 0)
+        throw BigIntegerException("Division by zero");
+
+    if (!is_neg())
+        return divide_bytes_by_word(begin(), end(), word, nullptr);
+
+    BigInteger magnitude(*this);
+    magnitude.negate();
+    const uint64_t r = divide_bytes_by_word(magnitude.begin(), magnitude.end(), word, nullptr);
+    return r == 0 ? 0 : word - r;
+}
+
 int BigInteger::compare(const BigInteger &a, const BigInteger &b) {
+    BIGINTEGER_STATS_SCOPE(COMPARE, std::min(a.size(), b.size()));
     if (a.is_neg() == b.is_neg()) {
         if (a.size() != b.size()) {
             if (a.is_neg())
@@ -462,34 +1059,173 @@ int BigInteger::compare(const BigInteger &a, const BigInteger &b) {
             else
                 return a.size() - b.size();
         }
-        for (const Byte *a_it = a.begin(), *b_it = b.begin(); a_it < a.end(); a_it++, b_it++) {
-            for (Byte k = 0; k < BITS_IN_BYTE; k++) {
-                Byte mask = get_one_bit_mask(BITS_IN_BYTE - 1 - k);
-                int a_bit = (*a_it & mask);
-                int b_bit = (*b_it & mask);
-                if (a_bit != b_bit) {
-                    if (a.is_neg())
-                        return b_bit - a_bit;
-                    else
-                        return a_bit - b_bit;
-                }
-            }
-        }
-        return 0;
+        // of the same sign and size, the two's complements order as unsigned big-endian bytes
+        if (a.begin() == b.begin())
+            return 0;
+        return std::memcmp(a.begin(), b.begin(), static_cast<size_t>(a.size()));
     } else {
         return a.is_neg() ? -1 : 1;
     }
 }
 
-BigInteger BigInteger::divide_positive(const BigInteger &a, const BigInteger &b) {
-    if (compare(a, b) < 0)
-        return ZERO;
-    BigInteger q = divide_positive(a, b << 1);
-    q <<= 1;
-    if (compare(a - q * b, b) < 0)
-        return q;
-    else
-        return ++q;
+bool BigInteger::equal(const BigInteger &a, const BigInteger &b) {
+    BIGINTEGER_STATS_SCOPE(COMPARE, std::min(a.size(), b.size()));
+    if (a._neg != b._neg || a._size != b._size)
+        return false;
+    // copies sharing a buffer
+    return a.begin() == b.begin() || std::memcmp(a.begin(), b.begin(), static_cast<size_t>(a.size())) == 0;
+}
+
+size_t BigInteger::hash() const &{
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    auto mix = [](uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    };
+
+    // the sign and size, whole words from the low end, then the top bytes zero-extended;
+    // 255 and -1 share their one byte, so the sign cannot be left out
+    uint64_t h = (static_cast<uint64_t>(size()) << 1 | (_neg ? 1 : 0)) * multiplier;
+    const Byte *word = end();
+    for (; word - begin() >= 8; word -= 8) {
+        uint64_t w;
+        std::memcpy(&w, word - 8, sizeof(w));
+        h = (h ^ w) * multiplier;
+        h ^= h >> 29;
+    }
+    if (word > begin()) {
+        uint64_t w = 0;
+        std::memcpy(&w, begin(), static_cast<size_t>(word - begin()));
+        h = (h ^ w) * multiplier;
+    }
+    return static_cast<size_t>(mix(h));
+}
+
+vector<uint64_t> BigInteger::magnitude_words(const BigInteger &a) {
+    if (!a.is_neg())
+        return load_words(a.begin(), a.end());
+    BigInteger magnitude(a);
+    magnitude.negate();
+    return load_words(magnitude.begin(), magnitude.end());
+}
+
+// sets the value to the little-endian magnitude words, negated if negative
+void BigInteger::assign_words(const uint64_t *words, const size_t count, const bool negative) {
+
+    const int new_size = static_cast<int>(count) * BYTES_IN_WORD + 1;
+    _size = 1;
+    if (new_size > capacity() || is_shared())
+        reallocate(std::max(new_size, _reserved));
+    _size = new_size;
+
+    Byte *it = end();
+    for (size_t i = 0; i < count; i++) {
+        it -= BYTES_IN_WORD;
+        store_word(it, BYTES_IN_WORD, words[i]);
+    }
+    *begin() = MIN_BYTE;
+    _neg = false;
+    normalize();
+
+    if (negative)
+        negate();
+}
+
+// |a| / |b| rounded down, |a| mod |b| left in remainder
+BigInteger BigInteger::divide_positive(const BigInteger &a, const BigInteger &b, BigInteger &remainder) {
+
+    BIGINTEGER_STATS_SCOPE(DIVIDE_POSITIVE, a.size());
+
+    vector<uint64_t> u = magnitude_words(a);
+    vector<uint64_t> v = magnitude_words(b);
+    const size_t n = u.size(), m = v.size();
+
+    BigInteger quotient;
+    if (n < m) {
+        remainder.assign_words(u.data(), n, false);
+        return quotient;
+    }
+
+    if (m == 1) {
+        const uint64_t r = mpn::divrem_1(u.data(), u.data(), n, v[0]);
+        quotient.assign_words(u.data(), n, false);
+        remainder.assign_words(&r, 1, false);
+        return quotient;
+    }
+
+    // the divisor shifted to have its top bit set, the dividend by as much into one more word
+    const unsigned int shift = static_cast<unsigned int>(mpn::leading_zeros(v[m - 1]));
+    u.push_back(0);
+    if (shift != 0) {
+        mpn::lshift(v.data(), v.data(), m, shift);
+        u[n] = mpn::lshift(u.data(), u.data(), n, shift);
+    }
+
+    vector<uint64_t> q(n - m + 2);
+    q[n - m + 1] = mpn::divrem(q.data(), u.data(), n + 1, v.data(), m);
+    if (shift != 0)
+        mpn::rshift(u.data(), u.data(), m, shift);
+
+    quotient.assign_words(q.data(), q.size(), false);
+    remainder.assign_words(u.data(), m, false);
+
+    return quotient;
+}
+
+// sets the value to count little-endian two's complement words
+void BigInteger::assign_twos_complement(const uint64_t *words, const size_t count) {
+
+    const int new_size = static_cast<int>(count) * BYTES_IN_WORD;
+    _size = 1;
+    if (new_size > capacity() || is_shared())
+        reallocate(std::max(new_size, _reserved));
+    _size = new_size;
+
+    Byte *it = end();
+    for (size_t i = 0; i < count; i++) {
+        it -= BYTES_IN_WORD;
+        store_word(it, BYTES_IN_WORD, words[i]);
+    }
+    _neg = (words[count - 1] >> 63) != 0;
+    normalize();
+}
+
+int BigInteger::capacity_for(const size_t digits, const int base) {
+    // a decimal digit takes less than 5/12 of a byte, plus room for one word multiplication;
+    // two hexadecimal digits a byte, plus the sign
+    const size_t bytes = base == 16 ? digits / 2 + 2 : digits / 12 * 5 + (digits % 12) * 5 / 12 + 2 * BYTES_IN_WORD;
+    return bytes > static_cast<size_t>(INT_MAX) ? -1 : static_cast<int>(bytes);
+}
+
+// DIGITS_IN_WORD digits at a time: one word multiplication and one word addition
+void BigInteger::assign_decimal(const char *first, const char *last, const bool negative) {
+
+    const size_t digits = static_cast<size_t>(last - first);
+    const int capacity = capacity_for(digits, 10);
+    if (capacity < 0)
+        throw BigIntegerException("Too many digits");
+    clear(capacity);
+
+    // the buffer already fits the whole value, trimming would only reallocate it meanwhile
+    const int reserved = _reserved;
+    _reserved = _capacity;
+
+    size_t chunk = digits % DIGITS_IN_WORD == 0 ? DIGITS_IN_WORD : digits % DIGITS_IN_WORD;
+    for (const char *it = first; it < last; it += chunk, chunk = DIGITS_IN_WORD) {
+        uint64_t value = 0;
+        for (const char *digit = it; digit < it + chunk; digit++)
+            value = value * 10 + static_cast<uint64_t>(*digit - '0');
+        multiply_word(POWERS_OF_TEN[chunk], false);
+        add_word(value, false);
+    }
+    _reserved = reserved;
+
+    if (negative)
+        negate();
 }
 
 ostream &operator<<(ostream &os, const BigInteger &number) {
@@ -498,11 +1234,13 @@ ostream &operator<<(ostream &os, const BigInteger &number) {
 }
 
 BigInteger operator>>(BigInteger a, unsigned int shift) {
-    return a >>= shift;
+    a >>= shift;
+    return a;
 }
 
 BigInteger operator<<(BigInteger a, unsigned int shift) {
-    return a <<= shift;
+    a <<= shift;
+    return a;
 }
 
 BigInteger operator+(BigInteger a, const BigInteger &b) {
@@ -522,7 +1260,7 @@ BigInteger operator/(BigInteger a, const BigInteger &b) {
 }
 
 BigInteger &operator++(BigInteger &a) {
-    return a += BigInteger::ONE;
+    return a += 1;
 }
 
 BigInteger operator++(BigInteger &a, int) {
@@ -532,7 +1270,7 @@ BigInteger operator++(BigInteger &a, int) {
 }
 
 BigInteger &operator--(BigInteger &a) {
-    return a -= BigInteger::ONE;
+    return a -= 1;
 }
 
 BigInteger operator--(BigInteger &a, int) {
@@ -545,12 +1283,28 @@ BigInteger operator-(BigInteger a) {
     return a.negate();
 }
 
+BigInteger operator&(BigInteger a, const BigInteger &b) {
+    return a &= b;
+}
+
+BigInteger operator|(BigInteger a, const BigInteger &b) {
+    return a |= b;
+}
+
+BigInteger operator^(BigInteger a, const BigInteger &b) {
+    return a ^= b;
+}
+
+BigInteger operator~(BigInteger a) {
+    return a.invert();
+}
+
 bool operator==(const BigInteger &a, const BigInteger &b) {
-    return BigInteger::compare(a, b) == 0;
+    return BigInteger::equal(a, b);
 }
 
 bool operator!=(const BigInteger &a, const BigInteger &b) {
-    return BigInteger::compare(a, b) != 0;
+    return !BigInteger::equal(a, b);
 }
 
 bool operator<=(const BigInteger &a, const BigInteger &b) {
@@ -571,14 +1325,26 @@ bool operator>(const BigInteger &a, const BigInteger &b) {
 
 BigInteger power(const BigInteger &a, const unsigned int m) {
 
-    if (a == BigInteger("2"))
+    BIGINTEGER_STATS_SCOPE(POWER, a.size());
+
+    if (m > 0 && a == BigInteger("2"))
         return a << m - 1;
 
+    if (a == BigInteger(10))
+        return BigIntegerPowerCache::power_of_ten(m);
+
     unsigned int n = m;
     BigInteger multiplier(a);
     BigInteger ans(BigInteger::ONE);
 
+    // one step per bit and one per set bit
+    uint64_t steps = 0, done = 0;
+    for (unsigned int rest = m; rest > 0; rest >>= 1)
+        steps += 1 + (rest & 1u);
+    BigIntegerCheckpoint checkpoint;
+
     while (n > 0) {
+        checkpoint.step(done++, steps);
         if (n % 2 == 1) {
             ans *= multiplier;
             n--;
@@ -590,3 +1356,32 @@ BigInteger power(const BigInteger &a, const unsigned int m) {
 
     return ans;
 }
+
+BigInteger gcd(const BigInteger &a, const BigInteger &b) {
+
+    BigInteger x(a), y(b);
+    if (x.is_neg())
+        x.negate();
+    if (y.is_neg())
+        y.negate();
+
+    while (!y.is_zero()) {
+        // once the divisor fits into a word the rest is machine arithmetic
+        if (y.size() <= BigInteger::BYTES_IN_WORD) {
+            uint64_t u = load_word(y.begin(), y.size());
+            uint64_t v = x.remainder(u);
+            while (v != 0) {
+                const uint64_t r = u % v;
+                u = v;
+                v = r;
+            }
+            return BigInteger(0) + u;
+        }
+        BigInteger remainder;
+        BigInteger::divide_positive(x, y, remainder);
+        x = std::move(y);
+        y = std::move(remainder);
+    }
+
+    return x;
+}
@@ -5,9 +5,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 using std::string;
 using std::ostream;
@@ -15,6 +20,10 @@ using std::exception;
 
 using Byte = unsigned char;
 
+namespace reference {
+    class Access;
+}
+
 
 class BigInteger {
 
@@ -28,9 +37,33 @@ public:
     static const Byte MIN_BYTE;
     static const Byte MAX_BYTE;
     static const int BYTE;
+    static const Byte BYTES_IN_WORD;
+    static const int DIGITS_IN_WORD = 19;
 
     class BigIntegerException;
 
+    // how buffers grow and when they give memory back, for all values of the process
+    struct GrowthPolicy {
+        // a full buffer grows by this percent of its capacity, or to the bytes needed if more
+        unsigned int growth_percent;
+        // a buffer above this percent of its value's size, by more than TRIM_SLACK bytes and
+        // past what reserve() asked for, is trimmed once the value shrinks; 0 never trims
+        unsigned int trim_percent;
+    };
+
+    static const GrowthPolicy DEFAULT_GROWTH_POLICY;
+    static const int TRIM_SLACK = 64;
+
+    static void set_growth_policy(GrowthPolicy);
+
+    static GrowthPolicy growth_policy();
+
+    // copies share the buffer of their source until either of them changes, for all values
+    // of the process; on by default
+    static void set_copy_on_write(bool);
+
+    static bool copy_on_write();
+
     BigInteger(string);
 
     BigInteger(long = 0) noexcept;
@@ -51,6 +84,15 @@ public:
 
     int capacity() const &{ return _capacity; }
 
+    // room for values of up to this many bits besides the sign, kept until shrink_to_fit()
+    void reserve(unsigned int bits) &;
+
+    // gives back all capacity past size(), and the reservation
+    void shrink_to_fit() &;
+
+    // whether copies still use this buffer
+    bool is_shared() const &;
+
     BigInteger &negate() &;
 
     string to_string() const &;
@@ -69,13 +111,96 @@ public:
 
     BigInteger &operator/=(const BigInteger &) &;
 
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    BigInteger &operator+=(T value) &{
+        return add_word(static_cast<uint64_t>(value), is_negative_word(value));
+    }
+
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    BigInteger &operator-=(T value) &{
+        return add_word(0 - static_cast<uint64_t>(value), value != 0 && !is_negative_word(value));
+    }
+
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    BigInteger &operator*=(T value) &{
+        return multiply_word(magnitude_word(value), is_negative_word(value));
+    }
+
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    BigInteger &operator/=(T value) &{
+        return divide_word(magnitude_word(value), is_negative_word(value));
+    }
+
+    // in [0, word), the remainder of operator/=
+    uint64_t remainder(uint64_t) const &;
+
+    BigInteger &operator&=(const BigInteger &) &;
+
+    BigInteger &operator|=(const BigInteger &) &;
+
+    BigInteger &operator^=(const BigInteger &) &;
+
+    BigInteger &invert() &;
+
+    bool test_bit(unsigned int) const &;
+
+    BigInteger &set_bit(unsigned int, bool = true) &;
+
+    // bits differing from the sign, as in the infinite two's complement
+    unsigned int popcount() const &;
+
+    // bits of the shortest two's complement, without the sign bit
+    unsigned int bit_length() const &;
+
+    // index of the lowest set bit, -1 for zero
+    int trailing_zeros() const &;
+
+    // the number of decimal digits without the sign, or one less or more; 1 for zero
+    size_t digits10_estimate() const &;
+
+    // of the absolute value, -infinity for zero
+    double log2() const &;
+
+    double log10() const &;
+
+    // rounded to nearest, ties to even; infinity beyond the range of double
+    double to_double() const &;
+
+    // the integer part, rounded toward zero; throws for infinities and NaN
+    static BigInteger from_double(double);
+
     static int compare(const BigInteger &, const BigInteger &);
 
+    // cheaper than compare() == 0: values of different sign or size are unequal
+    static bool equal(const BigInteger &, const BigInteger &);
+
+    // equal values hash alike whatever their capacity or sharing; all bytes are read every time
+    size_t hash() const &;
+
 private:
 
+    friend class reference::Access;
+
+    friend class BigAccumulator;
+
+    friend class BigDecimal;
+
+    friend class BigIntegerConversion;
+
+    friend class BigIntegerChars;
+
+    friend class BigIntegerRandom;
+
+    friend class BigRNS;
+
+    friend BigInteger gcd(const BigInteger &, const BigInteger &);
+
     bool _neg;
     int _size;
     int _capacity;
+    // bytes of capacity trimming keeps, from reserve()
+    int _reserved;
+    // preceded by the count of values using it, see allocate()
     Byte *_bytes;
 
     Byte *begin() { return _bytes + (_capacity - _size); }
@@ -88,21 +213,71 @@ private:
 
     Byte filler() const { return _neg ? BigInteger::MAX_BYTE : BigInteger::MIN_BYTE; };
 
+    bool is_zero() const { return _size == 1 && *begin() == 0; }
+
+    static Byte *allocate(int);
+
+    static void release(Byte *);
+
+    void detach();
+
+    void clear(int capacity);
+
+    void reallocate(int);
+
     void allocate_more();
 
-    void push_front(Byte);
+    void grow(int);
 
-    int first_significant_bit() const;
+    bool oversized() const;
 
-    void normalize();
+    void push_front(Byte);
 
-    static bool is_odd(char);
+    void normalize();
 
     static Byte get_one_bit_mask(Byte);
 
-    static bool divide_string_number_by_two(string &);
+    // bits of the absolute value
+    uint64_t magnitude_bits() const;
+
+    // bits [bit, bit + 64) of the infinite two's complement
+    uint64_t bits_at(uint64_t bit) const;
+
+    // the absolute value as the word times 2^shift: the whole of it if it fits a word, else its
+    // top 64 bits, with inexact telling whether lower ones were set
+    uint64_t magnitude_top(uint64_t &shift, bool &inexact) const;
+
+    static BigInteger divide_positive(const BigInteger &, const BigInteger &, BigInteger &remainder);
+
+    static std::vector<uint64_t> magnitude_words(const BigInteger &);
 
-    static BigInteger divide_positive(const BigInteger &, const BigInteger &);
+    void assign_words(const uint64_t *, size_t, bool negative);
+
+    void assign_twos_complement(const uint64_t *, size_t);
+
+    // bytes for any value of that many digits in base 10 or 16, -1 beyond an int
+    static int capacity_for(size_t digits, int base);
+
+    void assign_decimal(const char *first, const char *last, bool negative);
+
+    template<typename Operation>
+    BigInteger &apply_bitwise(const BigInteger &, Operation);
+
+    BigInteger &add_word(uint64_t, bool negative);
+
+    BigInteger &multiply_word(uint64_t, bool negative);
+
+    BigInteger &divide_word(uint64_t, bool negative);
+
+    uint64_t divide_magnitude_by_word(uint64_t);
+
+    template<typename T>
+    static bool is_negative_word(T value) { return std::is_signed<T>::value && static_cast<int64_t>(value) < 0; }
+
+    template<typename T>
+    static uint64_t magnitude_word(T value) {
+        return is_negative_word(value) ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    }
 };
 
 class BigInteger::BigIntegerException : exception {
@@ -134,6 +309,42 @@ BigInteger operator*(BigInteger, const BigInteger &);
 
 BigInteger operator/(BigInteger, const BigInteger &);
 
+template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+BigInteger operator+(BigInteger a, T b) {
+    a += b;
+    return a;
+}
+
+template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+BigInteger operator+(T a, BigInteger b) {
+    b += a;
+    return b;
+}
+
+template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+BigInteger operator-(BigInteger a, T b) {
+    a -= b;
+    return a;
+}
+
+template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+BigInteger operator*(BigInteger a, T b) {
+    a *= b;
+    return a;
+}
+
+template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+BigInteger operator*(T a, BigInteger b) {
+    b *= a;
+    return b;
+}
+
+template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+BigInteger operator/(BigInteger a, T b) {
+    a /= b;
+    return a;
+}
+
 bool operator==(const BigInteger &, const BigInteger &);
 
 bool operator!=(const BigInteger &, const BigInteger &);
@@ -156,4 +367,22 @@ BigInteger operator--(BigInteger &, int);
 
 BigInteger operator-(BigInteger);
 
+BigInteger operator&(BigInteger, const BigInteger &);
+
+BigInteger operator|(BigInteger, const BigInteger &);
+
+BigInteger operator^(BigInteger, const BigInteger &);
+
+BigInteger operator~(BigInteger);
+
 BigInteger power(const BigInteger &, unsigned int);
+
+// non-negative, gcd(0, 0) = 0
+BigInteger gcd(const BigInteger &, const BigInteger &);
+
+namespace std {
+    template<>
+    struct hash<BigInteger> {
+        size_t operator()(const BigInteger &value) const { return value.hash(); }
+    };
+}
@@ -0,0 +1,88 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <limits>
+#include "BigIntegerAsync.h"
+
+using std::future;
+
+static int64_t nanoseconds_of(const BigIntegerCancellation::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+BigIntegerCancellation::BigIntegerCancellation() :
+        _state(std::make_shared<State>()) {
+    _state->cancelled.store(false, std::memory_order_relaxed);
+    _state->deadline.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+}
+
+void BigIntegerCancellation::cancel() const &{
+    _state->cancelled.store(true, std::memory_order_relaxed);
+}
+
+void BigIntegerCancellation::cancel_at(const Clock::time_point time) const &{
+    _state->deadline.store(nanoseconds_of(time), std::memory_order_relaxed);
+}
+
+bool BigIntegerCancellation::cancelled() const &{
+    if (_state->cancelled.load(std::memory_order_relaxed))
+        return true;
+    const int64_t deadline = _state->deadline.load(std::memory_order_relaxed);
+    return deadline != std::numeric_limits<int64_t>::max() && nanoseconds_of(Clock::now()) >= deadline;
+}
+
+BigIntegerAsync::Options::Options() :
+        cancellation(),
+        progress(),
+        executor(&BigIntegerThreadPool::shared()) {}
+
+BigIntegerAsync::Context *&BigIntegerAsync::current() {
+    static thread_local Context *context = nullptr;
+    return context;
+}
+
+BigIntegerAsync::Scope::Scope(const Options &options) :
+        _context{&options, 0, 0.0},
+        _previous(current()) {
+
+    if (options.cancellation.cancelled())
+        throw BigInteger::BigIntegerException("Operation cancelled");
+    current() = &_context;
+}
+
+BigIntegerAsync::Scope::~Scope() {
+    current() = _previous;
+}
+
+void BigIntegerAsync::step(Context &context, const bool outermost, const uint64_t done, const uint64_t total) {
+
+    if (context.options->cancellation.cancelled())
+        throw BigInteger::BigIntegerException("Operation cancelled");
+
+    if (!outermost || !context.options->progress || total == 0)
+        return;
+    const double fraction = static_cast<double>(done) / static_cast<double>(total);
+    if (fraction >= context.reported + 0.01 && fraction < 1.0) {
+        context.reported = fraction;
+        context.options->progress(fraction);
+    }
+}
+
+future<BigInteger> BigIntegerAsync::multiply(BigInteger a, BigInteger b, Options options) {
+    return run([a, b]() { return a * b; }, std::move(options));
+}
+
+future<BigInteger> BigIntegerAsync::divide(BigInteger a, BigInteger b, Options options) {
+    return run([a, b]() { return a / b; }, std::move(options));
+}
+
+future<BigInteger> BigIntegerAsync::power(BigInteger a, const unsigned int exponent, Options options) {
+    return run([a, exponent]() { return ::power(a, exponent); }, std::move(options));
+}
+
+future<string> BigIntegerAsync::to_string(BigInteger a, Options options) {
+    return run([a]() { return a.to_string(); }, std::move(options));
+}
@@ -0,0 +1,150 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include "BigInteger.h"
+#include "BigIntegerThreadPool.h"
+
+using std::string;
+
+
+// Shared flag to stop an operation started through BigIntegerAsync. Copies refer to the
+// same flag, cancelling any of them cancels them all.
+class BigIntegerCancellation {
+
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    BigIntegerCancellation();
+
+    void cancel() const &;
+
+    // cancels once the time point has passed
+    void cancel_at(Clock::time_point) const &;
+
+    bool cancelled() const &;
+
+private:
+
+    struct State {
+        std::atomic<bool> cancelled;
+        std::atomic<int64_t> deadline;
+    };
+
+    std::shared_ptr<State> _state;
+};
+
+
+// Long operations run as tasks of a thread pool, each returning a future. The kernels
+// check the cancellation between rows of a multiplication, words of a quotient, steps of
+// a power and chunks of a conversion; a cancelled operation ends its future with
+// BigIntegerException("Operation cancelled"). Progress below 1 is reported by the
+// outermost kernel, in steps of at least a percent; the future tells when it is done.
+class BigIntegerAsync {
+
+public:
+
+    using Progress = std::function<void(double)>;
+
+    struct Options {
+        BigIntegerCancellation cancellation;
+        Progress progress;
+        // the shared pool by default, a pool without threads runs the task only when waited for through it
+        BigIntegerThreadPool *executor;
+
+        Options();
+    };
+
+    static std::future<BigInteger> multiply(BigInteger, BigInteger, Options = Options());
+
+    static std::future<BigInteger> divide(BigInteger, BigInteger, Options = Options());
+
+    static std::future<BigInteger> power(BigInteger, unsigned int, Options = Options());
+
+    static std::future<string> to_string(BigInteger, Options = Options());
+
+    // runs any callable on the executor with the cancellation and progress of the options
+    template<typename Operation>
+    static std::future<typename std::result_of<Operation()>::type> run(Operation operation, Options options) {
+        using Result = typename std::result_of<Operation()>::type;
+        BigIntegerThreadPool *executor = options.executor;
+        std::shared_ptr<Options> shared = std::make_shared<Options>(std::move(options));
+        return executor->submit([operation, shared]() -> Result {
+            Scope scope(*shared);
+            return operation();
+        });
+    }
+
+private:
+
+    friend class BigIntegerCheckpoint;
+
+    struct Context {
+        const Options *options;
+        int depth;
+        double reported;
+    };
+
+    // makes the options current for the kernels running on this thread
+    class Scope {
+
+    public:
+
+        explicit Scope(const Options &);
+
+        ~Scope();
+
+    private:
+
+        Context _context;
+        Context *_previous;
+    };
+
+    static Context *&current();
+
+    static void step(Context &, bool outermost, uint64_t done, uint64_t total);
+};
+
+
+// Placed by a kernel around its main loop, costs one thread-local read when no
+// asynchronous operation is running on the thread.
+class BigIntegerCheckpoint {
+
+public:
+
+    BigIntegerCheckpoint() : _context(BigIntegerAsync::current()), _outermost(false) {
+        if (_context != nullptr)
+            _outermost = ++_context->depth == 1;
+    }
+
+    BigIntegerCheckpoint(const BigIntegerCheckpoint &) = delete;
+
+    BigIntegerCheckpoint &operator=(const BigIntegerCheckpoint &) = delete;
+
+    ~BigIntegerCheckpoint() {
+        if (_context != nullptr)
+            --_context->depth;
+    }
+
+    // throws if the operation was cancelled
+    void step(const uint64_t done, const uint64_t total) {
+        if (_context != nullptr)
+            BigIntegerAsync::step(*_context, _outermost, done, total);
+    }
+
+private:
+
+    BigIntegerAsync::Context *_context;
+    bool _outermost;
+};
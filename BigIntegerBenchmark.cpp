@@ -0,0 +1,329 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include "BigIntegerBenchmark.h"
+#include "BigIntegerConversion.h"
+#include "BigIntegerRandom.h"
+
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::ifstream;
+using std::ofstream;
+using std::map;
+using std::pair;
+
+using Clock = std::chrono::steady_clock;
+
+static atomic<long> allocations(0);
+static atomic<long> allocated_bytes(0);
+static volatile long sink = 0;
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(static_cast<long>(size), std::memory_order_relaxed);
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+int BigIntegerBenchmark::run(const Options &options) {
+
+    vector<Result> results;
+
+    for (const Benchmark &benchmark : benchmarks()) {
+        if (!options.filter.empty() && benchmark.operation != options.filter)
+            continue;
+
+        Generator generator(options.seed);
+        for (int bits : sizes(options)) {
+            Operation operation = benchmark.prepare(bits, generator);
+            Result result = measure(benchmark.operation, bits, operation, options);
+            print(result);
+            results.push_back(result);
+
+            if (result.ns_per_op > options.budget_ms * 1e6) {
+                cout << benchmark.operation << ": over budget, skipping larger sizes" << endl;
+                break;
+            }
+        }
+    }
+
+    if (!options.json_path.empty())
+        write_json(options.json_path, results);
+
+    if (!options.baseline_path.empty())
+        return compare_with_baseline(results, read_json(options.baseline_path), options.threshold);
+
+    return 0;
+}
+
+vector<BigIntegerBenchmark::Benchmark> BigIntegerBenchmark::benchmarks() {
+
+    vector<Benchmark> list;
+
+    list.push_back({"parse", [](int bits, Generator &g) -> Operation {
+        string number = random_decimal(bits, g);
+        return [number]() { sink += BigInteger(number).size(); };
+    }});
+
+    list.push_back({"to_string", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        return [a]() { sink += static_cast<long>(a.to_string().size()); };
+    }});
+
+    list.push_back({"parse_parallel", [](int bits, Generator &g) -> Operation {
+        string number = random_decimal(bits, g);
+        return [number]() { sink += BigIntegerConversion::parse(number).size(); };
+    }});
+
+    list.push_back({"to_string_parallel", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        return [a]() { sink += static_cast<long>(BigIntegerConversion::to_string(a).size()); };
+    }});
+
+    list.push_back({"add", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g), b = random_number(bits, g);
+        return [a, b]() { sink += (a + b).size(); };
+    }});
+
+    list.push_back({"sub", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g), b = random_number(bits, g);
+        return [a, b]() { sink += (a - b).size(); };
+    }});
+
+    list.push_back({"mul", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g), b = random_number(bits, g);
+        return [a, b]() { sink += (a * b).size(); };
+    }});
+
+    list.push_back({"div", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits * 2, g), b = random_number(bits, g);
+        return [a, b]() { sink += (a / b).size(); };
+    }});
+
+    list.push_back({"shl", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        unsigned int shift = static_cast<unsigned int>(bits / 2 + 3);
+        return [a, shift]() { sink += (a << shift).size(); };
+    }});
+
+    list.push_back({"shr", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        unsigned int shift = static_cast<unsigned int>(bits / 2 + 3);
+        return [a, shift]() { sink += (a >> shift).size(); };
+    }});
+
+    list.push_back({"compare", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        // a buffer of its own, so the bytes are compared
+        BigInteger b = -(-a);
+        return [a, b]() { sink += BigInteger::compare(a, b); };
+    }});
+
+    list.push_back({"compare_shared", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        // a copy sharing the buffer of a
+        BigInteger b(a);
+        return [a, b]() { sink += BigInteger::compare(a, b); };
+    }});
+
+    list.push_back({"equal", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        // a buffer of its own, so the bytes are compared
+        BigInteger b = -(-a);
+        return [a, b]() { sink += a == b; };
+    }});
+
+    list.push_back({"hash", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(bits, g);
+        return [a]() { sink += static_cast<long>(std::hash<BigInteger>()(a) & 1); };
+    }});
+
+    list.push_back({"power", [](int bits, Generator &g) -> Operation {
+        BigInteger a = random_number(63, g);
+        unsigned int exponent = static_cast<unsigned int>(bits / 63 + 1);
+        return [a, exponent]() { sink += power(a, exponent).size(); };
+    }});
+
+    return list;
+}
+
+vector<int> BigIntegerBenchmark::sizes(const Options &options) {
+    vector<int> list;
+    for (long bits = options.min_bits; bits < options.max_bits; bits *= 4)
+        list.push_back(static_cast<int>(bits));
+    list.push_back(options.max_bits);
+    return list;
+}
+
+BigIntegerBenchmark::Result BigIntegerBenchmark::measure
+        (const string &operation_name, const int bits, const Operation &operation, const Options &options) {
+
+    const long allocations_before = allocations.load();
+    const long bytes_before = allocated_bytes.load();
+
+    long iterations = 0;
+    double elapsed_ns = 0;
+    long batch = 1;
+
+    do {
+        Clock::time_point start = Clock::now();
+        for (long i = 0; i < batch; i++)
+            operation();
+        elapsed_ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        iterations += batch;
+        batch *= 2;
+    } while (elapsed_ns < options.min_time_ms * 1e6 && elapsed_ns / iterations < options.budget_ms * 1e6);
+
+    Result result;
+    result.operation = operation_name;
+    result.bits = bits;
+    result.iterations = iterations;
+    result.ns_per_op = elapsed_ns / iterations;
+    result.mb_per_s = (bits / 8.0) / result.ns_per_op * 1e3;
+    result.allocs_per_op = static_cast<double>(allocations.load() - allocations_before) / iterations;
+    result.bytes_per_op = static_cast<double>(allocated_bytes.load() - bytes_before) / iterations;
+    return result;
+}
+
+BigInteger BigIntegerBenchmark::random_number(const int bits, Generator &generator) {
+    BigInteger number = BigIntegerRandom::random_bits(static_cast<unsigned int>(bits - 1), generator);
+    number.set_bit(static_cast<unsigned int>(bits - 1));
+    return number;
+}
+
+string BigIntegerBenchmark::random_decimal(const int bits, Generator &generator) {
+    // 0.30103 decimal digits per bit
+    int digits = static_cast<int>(bits * 0.30103) + 1;
+    string number(static_cast<size_t>(digits), '0');
+    number[0] = static_cast<char>('1' + generator() % 9);
+    for (int i = 1; i < digits; i++)
+        number[i] = static_cast<char>('0' + generator() % 10);
+    return number;
+}
+
+void BigIntegerBenchmark::print(const Result &result) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-10s %9d bits %12ld iter %16.1f ns/op %10.2f MB/s %8.1f allocs/op %14.0f B/op",
+                  result.operation.c_str(), result.bits, result.iterations, result.ns_per_op,
+                  result.mb_per_s, result.allocs_per_op, result.bytes_per_op);
+    cout << line << endl;
+}
+
+void BigIntegerBenchmark::write_json(const string &path, const vector<Result> &results) {
+
+    ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot write " << path << endl;
+        return;
+    }
+
+    out << "{\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"operation\": \"%s\", \"bits\": %d, \"iterations\": %ld, \"ns_per_op\": %.3f, "
+                      "\"mb_per_s\": %.3f, \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f}",
+                      r.operation.c_str(), r.bits, r.iterations, r.ns_per_op,
+                      r.mb_per_s, r.allocs_per_op, r.bytes_per_op);
+        out << line << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+static string json_string_field(const string &line, const string &key) {
+    size_t pos = line.find("\"" + key + "\"");
+    if (pos == string::npos)
+        return "";
+    pos = line.find(':', pos);
+    if (pos == string::npos)
+        return "";
+    size_t begin = line.find_first_not_of(" \"", pos + 1);
+    size_t end = line.find_first_of(",\"}", begin);
+    if (begin == string::npos || end == string::npos)
+        return "";
+    return line.substr(begin, end - begin);
+}
+
+// reads files produced by write_json, one result per line
+vector<BigIntegerBenchmark::Result> BigIntegerBenchmark::read_json(const string &path) {
+
+    vector<Result> results;
+    ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot read baseline " << path << endl;
+        return results;
+    }
+
+    string line;
+    while (std::getline(in, line)) {
+        if (line.find("\"operation\"") == string::npos)
+            continue;
+        Result r;
+        r.operation = json_string_field(line, "operation");
+        r.bits = std::atoi(json_string_field(line, "bits").c_str());
+        r.iterations = std::atol(json_string_field(line, "iterations").c_str());
+        r.ns_per_op = std::atof(json_string_field(line, "ns_per_op").c_str());
+        r.mb_per_s = std::atof(json_string_field(line, "mb_per_s").c_str());
+        r.allocs_per_op = std::atof(json_string_field(line, "allocs_per_op").c_str());
+        r.bytes_per_op = std::atof(json_string_field(line, "bytes_per_op").c_str());
+        results.push_back(r);
+    }
+    return results;
+}
+
+int BigIntegerBenchmark::compare_with_baseline
+        (const vector<Result> &results, const vector<Result> &baseline, const double threshold) {
+
+    map<pair<string, int>, double> baseline_ns;
+    for (const Result &r : baseline)
+        baseline_ns[{r.operation, r.bits}] = r.ns_per_op;
+
+    cout << "\nComparing with baseline (threshold " << threshold * 100 << "%)\n\n";
+
+    int regressions = 0;
+    for (const Result &r : results) {
+        auto it = baseline_ns.find({r.operation, r.bits});
+        if (it == baseline_ns.end() || it->second <= 0)
+            continue;
+
+        double ratio = r.ns_per_op / it->second;
+        const char *verdict = "ok";
+        if (ratio > 1 + threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (ratio < 1 - threshold) {
+            verdict = "improved";
+        }
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-10s %9d bits %8.3fx  %s",
+                      r.operation.c_str(), r.bits, ratio, verdict);
+        cout << line << endl;
+    }
+
+    cout << "\n" << regressions << " regression(s)\n";
+    return regressions > 0 ? 1 : 0;
+}
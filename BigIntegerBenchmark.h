@@ -0,0 +1,75 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "BigInteger.h"
+
+using std::string;
+using std::vector;
+
+
+class BigIntegerBenchmark {
+
+public:
+
+    struct Options {
+        int min_bits = 64;
+        int max_bits = 10000000;
+        double min_time_ms = 100;
+        double budget_ms = 2000;
+        double threshold = 0.10;
+        unsigned int seed = 12345;
+        string filter;
+        string json_path;
+        string baseline_path;
+    };
+
+    struct Result {
+        string operation;
+        int bits;
+        long iterations;
+        double ns_per_op;
+        double mb_per_s;
+        double allocs_per_op;
+        double bytes_per_op;
+    };
+
+    // runs every operation over the size sweep, returns non-zero when a regression was found
+    static int run(const Options &);
+
+private:
+
+    using Generator = std::mt19937_64;
+    using Operation = std::function<void()>;
+    using Preparer = std::function<Operation(int bits, Generator &)>;
+
+    struct Benchmark {
+        string operation;
+        Preparer prepare;
+    };
+
+    static vector<Benchmark> benchmarks();
+
+    static vector<int> sizes(const Options &);
+
+    static Result measure(const string &operation, int bits, const Operation &, const Options &);
+
+    static BigInteger random_number(int bits, Generator &);
+
+    static string random_decimal(int bits, Generator &);
+
+    static void print(const Result &);
+
+    static void write_json(const string &path, const vector<Result> &);
+
+    static vector<Result> read_json(const string &path);
+
+    static int compare_with_baseline(const vector<Result> &, const vector<Result> &baseline, double threshold);
+};
@@ -0,0 +1,215 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <cstring>
+#include "BigIntegerChars.h"
+#include "BigIntegerKernels.h"
+#include "BigIntegerStats.h"
+
+static const uint64_t TEN_TO_DIGITS_IN_WORD = 10000000000000000000ull;
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+// the bytes of the absolute value of two's complement bytes from the least significant one,
+// followed by zeros; a negative value is negated on the way
+class MagnitudeBytes {
+
+private:
+
+    const Byte *const _first;
+    const Byte *_it;
+    const Byte _flip;
+    unsigned int _carry;
+
+public:
+
+    MagnitudeBytes(const Byte *first, const Byte *last, const bool negative) :
+            _first(first),
+            _it(last),
+            _flip(negative ? BigInteger::MAX_BYTE : BigInteger::MIN_BYTE),
+            _carry(negative ? 1 : 0) {}
+
+    Byte next() {
+        _carry += static_cast<Byte>((_it > _first ? *--_it : _flip) ^ _flip);
+        const Byte byte = static_cast<Byte>(_carry);
+        _carry >>= 8;
+        return byte;
+    }
+};
+
+void BigIntegerChars::store_magnitude(const BigInteger &value, char *words, const size_t count) {
+    MagnitudeBytes bytes(value.begin(), value.end(), value.is_neg());
+    for (size_t i = 0; i < count; i++) {
+        uint64_t word = 0;
+        for (int k = 0; k < 8; k++)
+            word |= static_cast<uint64_t>(bytes.next()) << (8 * k);
+        std::memcpy(words + 8 * i, &word, sizeof(word));
+    }
+}
+
+// 19 digits at a time from the lowest, written from last down and moved to first at the end.
+// Every division leaves fewer words than digits to go, so the words kept at first never meet
+// the digits coming down unless the range is too short; nullptr then
+char *BigIntegerChars::write_decimal(const BigInteger &value, char *first, char *last) {
+
+    const uint64_t bits = value.magnitude_bits();
+    size_t count = bits <= 64 ? 1 : static_cast<size_t>((bits + 63) / 64);
+
+    char *it = last;
+    uint64_t top = 0;
+    if (count == 1) {
+        char word[8];
+        store_magnitude(value, word, 1);
+        std::memcpy(&top, word, sizeof(top));
+    } else {
+        // at least 20 digits, more than the bytes of the words
+        if (static_cast<size_t>(last - first) < 8 * count)
+            return nullptr;
+        store_magnitude(value, first, count);
+
+        // 10^19 has its top bit set, no normalization needed
+        const uint64_t v = mpn::reciprocal(TEN_TO_DIGITS_IN_WORD);
+        while (count > 1) {
+            uint64_t remainder = 0, highest = 0;
+            for (size_t i = count; i-- > 0;) {
+                uint64_t word;
+                std::memcpy(&word, first + 8 * i, sizeof(word));
+                word = mpn::divide_words(remainder, word, TEN_TO_DIGITS_IN_WORD, v, remainder);
+                std::memcpy(first + 8 * i, &word, sizeof(word));
+                if (i == count - 1)
+                    highest = word;
+            }
+            if (highest == 0)
+                count--;
+
+            // the last word is taken out before the digits may cover it
+            size_t kept = 8 * count;
+            if (count == 1) {
+                std::memcpy(&top, first, sizeof(top));
+                kept = 0;
+            }
+            if (static_cast<size_t>(it - first) < kept + BigInteger::DIGITS_IN_WORD)
+                return nullptr;
+            for (int k = 0; k < BigInteger::DIGITS_IN_WORD; k++, remainder /= 10)
+                *--it = static_cast<char>('0' + remainder % 10);
+        }
+    }
+
+    do {
+        if (it == first)
+            return nullptr;
+        *--it = static_cast<char>('0' + top % 10);
+        top /= 10;
+    } while (top != 0);
+
+    const size_t length = static_cast<size_t>(last - it);
+    std::memmove(first, it, length);
+    return first + length;
+}
+
+char *BigIntegerChars::write_hex(const BigInteger &value, char *first, char *last) {
+
+    const uint64_t bits = value.magnitude_bits();
+    const uint64_t digits = bits == 0 ? 1 : (bits + 3) / 4;
+    if (static_cast<uint64_t>(last - first) < digits)
+        return nullptr;
+
+    MagnitudeBytes bytes(value.begin(), value.end(), value.is_neg());
+    char *end = first + digits;
+    for (char *it = end; it > first;) {
+        const Byte byte = bytes.next();
+        *--it = HEX_DIGITS[byte & 15];
+        if (it > first)
+            *--it = HEX_DIGITS[byte >> 4];
+    }
+    return end;
+}
+
+int BigIntegerChars::digit_value(const char c, const int base) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (base == 16 && c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (base == 16 && c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return base;
+}
+
+BigIntegerChars::ToCharsResult BigIntegerChars::to_chars(char *first, char *last, const BigInteger &value,
+                                                         const int base) {
+
+    BIGINTEGER_STATS_SCOPE(TO_STRING, value.size());
+
+    if (base != 10 && base != 16)
+        return {first, std::errc::invalid_argument};
+
+    char *digits = first;
+    if (value.is_neg()) {
+        if (first == last)
+            return {last, std::errc::value_too_large};
+        *digits++ = '-';
+    }
+
+    char *end = base == 10 ? write_decimal(value, digits, last) : write_hex(value, digits, last);
+    if (end == nullptr)
+        return {last, std::errc::value_too_large};
+    return {end, std::errc()};
+}
+
+BigIntegerChars::FromCharsResult BigIntegerChars::from_chars(const char *first, const char *last, BigInteger &value,
+                                                             const int base) {
+
+    BIGINTEGER_STATS_SCOPE(PARSE, static_cast<size_t>(last - first) * 5 / 12 + 1);
+
+    if (base != 10 && base != 16)
+        return {first, std::errc::invalid_argument};
+
+    const bool negative = first < last && *first == '-';
+    const char *digits = negative ? first + 1 : first;
+    const char *end = digits;
+    while (end < last && digit_value(*end, base) < base)
+        end++;
+    if (end == digits)
+        return {first, std::errc::invalid_argument};
+
+    const int capacity = BigInteger::capacity_for(static_cast<size_t>(end - digits), base);
+    if (capacity < 0)
+        return {end, std::errc::result_out_of_range};
+
+    if (base == 10) {
+        value.assign_decimal(digits, end, negative);
+        return {end, std::errc()};
+    }
+
+    // two digits a byte from the lowest, and a zero byte on top for the sign
+    value.clear(capacity);
+    value._size = static_cast<int>((end - digits + 1) / 2) + 1;
+    Byte *byte = value.end();
+    for (const char *it = end; it > digits;) {
+        int bits = digit_value(*--it, base);
+        if (it > digits)
+            bits |= digit_value(*--it, base) << 4;
+        *--byte = static_cast<Byte>(bits);
+    }
+    *value.begin() = BigInteger::MIN_BYTE;
+    value.normalize();
+    if (negative)
+        value.negate();
+
+    return {end, std::errc()};
+}
+
+size_t BigIntegerChars::digits_needed(const BigInteger &value, const int base) {
+
+    const uint64_t bits = value.magnitude_bits();
+    const size_t sign = value.is_neg() ? 1 : 0;
+
+    // a value below 2^bits has at most bits log10(2) + 1 digits
+    if (base == 10)
+        return static_cast<size_t>(bits * 30103 / 100000 + 1) + sign;
+    if (base == 16)
+        return static_cast<size_t>(bits == 0 ? 1 : (bits + 3) / 4) + sign;
+    return 0;
+}
@@ -0,0 +1,55 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstddef>
+#include <system_error>
+#include "BigInteger.h"
+
+
+// Text conversion into and out of caller-supplied char ranges, in the manner of
+// std::to_chars and std::from_chars: errors come back as std::errc instead of exceptions,
+// and no string is built. Bases 10 and 16; the digits are preceded by '-' for negative
+// values and by nothing else, hexadecimal digits are written in lower case.
+class BigIntegerChars {
+
+public:
+
+    struct ToCharsResult {
+        char *ptr;
+        std::errc ec;
+    };
+
+    struct FromCharsResult {
+        const char *ptr;
+        std::errc ec;
+    };
+
+    // writes no terminating '\0'. If the range is too short, returns value_too_large and last,
+    // the range is then left with unspecified contents. Allocates nothing: for base 10 the
+    // magnitude is divided in place in the part of the range the digits have not reached yet
+    static ToCharsResult to_chars(char *first, char *last, const BigInteger &, int base = 10);
+
+    // reads the longest prefix of an optional '-' and digits. Without digits returns invalid_argument
+    // and first, and leaves the value alone. The value keeps its buffer if the result fits
+    static FromCharsResult from_chars(const char *first, const char *last, BigInteger &, int base = 10);
+
+    // the characters to_chars writes at most, sign included: exact for base 16,
+    // for base 10 at most one more than needed; 0 for other bases
+    static size_t digits_needed(const BigInteger &, int base = 10);
+
+private:
+
+    // the magnitude as count little-endian words, unaligned
+    static void store_magnitude(const BigInteger &, char *words, size_t count);
+
+    static char *write_decimal(const BigInteger &, char *first, char *last);
+
+    static char *write_hex(const BigInteger &, char *first, char *last);
+
+    // the value of a digit character, base or more if it is none
+    static int digit_value(char, int base);
+};
@@ -0,0 +1,174 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include <future>
+#include "BigIntegerConversion.h"
+#include "BigIntegerStats.h"
+#include "BigIntegerThresholds.h"
+
+using std::future;
+
+static const uint64_t TEN_TO_DIGITS_IN_WORD = 10000000000000000000ull;
+
+const int BigIntegerConversion::TASK_BYTES;
+const size_t BigIntegerConversion::TASK_DIGITS;
+
+// 19 digits for every 8 bytes, as a word holds
+size_t BigIntegerConversion::leaf_digits() {
+    return BigIntegerThresholds::get(BigIntegerThresholds::CONVERSION_LEAF) * 19 / 8;
+}
+
+vector<const BigInteger *> BigIntegerConversion::powers_of_ten(const size_t levels, vector<BigInteger> &uncached) {
+    vector<const BigInteger *> powers;
+    powers.reserve(levels);
+    // no reallocation, the pointers into it stay valid
+    uncached.reserve(levels);
+    for (unsigned int k = 0; k < levels; k++) {
+        const BigInteger *cached = BigIntegerPowerCache::level(k);
+        if (cached == nullptr) {
+            uncached.push_back(k == 0 ? BigInteger(1) * TEN_TO_DIGITS_IN_WORD : *powers.back() * *powers.back());
+            cached = &uncached.back();
+        }
+        powers.push_back(cached);
+    }
+    return powers;
+}
+
+string BigIntegerConversion::to_string(const BigInteger &value, BigIntegerThreadPool &pool) {
+
+    BIGINTEGER_STATS_SCOPE(TO_STRING, value.size());
+
+    BigInteger magnitude(value);
+    if (magnitude.is_neg())
+        magnitude.negate();
+
+    // a value of b bits has at most b log10(2) + 1 digits
+    const size_t digits = static_cast<size_t>(magnitude.bit_length()) * 30103 / 100000 + 1;
+    size_t level = 0;
+    while ((static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << level) < digits)
+        level++;
+
+    vector<BigInteger> uncached;
+    const vector<const BigInteger *> powers = powers_of_ten(level, uncached);
+
+    string ans(BigInteger::DIGITS_IN_WORD << level, '0');
+    format(std::move(magnitude), level, powers, &ans[0], pool);
+
+    const size_t first = std::min(ans.find_first_not_of('0'), ans.size() - 1);
+    ans.erase(0, first);
+    if (value.is_neg())
+        ans.insert(ans.begin(), '-');
+
+    return ans;
+}
+
+void BigIntegerConversion::format(BigInteger magnitude, const size_t level, const vector<const BigInteger *> &powers,
+                                  char *digits, BigIntegerThreadPool &pool) {
+
+    const size_t width = static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << level;
+
+    const size_t leaf_bytes = BigIntegerThresholds::get(BigIntegerThresholds::CONVERSION_LEAF);
+    if (level == 0 || static_cast<size_t>(magnitude.size()) <= leaf_bytes) {
+        char *it = digits + width;
+        while (!magnitude.is_zero()) {
+            uint64_t chunk = magnitude.divide_magnitude_by_word(TEN_TO_DIGITS_IN_WORD);
+            for (int k = 0; k < BigInteger::DIGITS_IN_WORD; k++, chunk /= 10)
+                *--it = static_cast<char>('0' + chunk % 10);
+        }
+        std::fill(digits, it, '0');
+        return;
+    }
+
+    BigInteger low;
+    BigInteger high = BigInteger::divide_positive(magnitude, *powers[level - 1], low);
+    const bool parallel = magnitude.size() >= TASK_BYTES;
+    magnitude = BigInteger();
+
+    if (!parallel) {
+        format(std::move(high), level - 1, powers, digits, pool);
+        format(std::move(low), level - 1, powers, digits + width / 2, pool);
+        return;
+    }
+
+    future<void> task = pool.submit([&high, level, &powers, digits, &pool]() {
+        format(std::move(high), level - 1, powers, digits, pool);
+    });
+    try {
+        format(std::move(low), level - 1, powers, digits + width / 2, pool);
+    } catch (...) {
+        // the task still refers to high and to the buffer
+        task.wait();
+        throw;
+    }
+    pool.wait(task);
+}
+
+BigInteger BigIntegerConversion::parse(const string &number, BigIntegerThreadPool &pool) {
+
+    const size_t first = !number.empty() && number[0] == '-' ? 1 : 0;
+    if (number.size() - first <= leaf_digits())
+        return BigInteger(number);
+
+    BIGINTEGER_STATS_SCOPE(PARSE, number.size() * 5 / 12 + 1);
+
+    for (size_t i = first; i < number.size(); i++)
+        if (number[i] < '0' || number[i] > '9')
+            throw BigInteger::BigIntegerException("Illegal string parameter");
+
+    // the lowest part of every split is 19 2^k digits, 19 2^k below the length of the whole
+    const size_t digits = number.size() - first;
+    size_t levels = 1;
+    while ((static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << levels) < digits)
+        levels++;
+
+    vector<BigInteger> uncached;
+    const vector<const BigInteger *> powers = powers_of_ten(levels, uncached);
+
+    const char *data = number.data();
+    BigInteger ans = parse_digits(data + first, data + number.size(), powers, pool);
+    if (first == 1)
+        ans.negate();
+
+    return ans;
+}
+
+BigInteger BigIntegerConversion::parse_digits(const char *first, const char *last,
+                                              const vector<const BigInteger *> &powers, BigIntegerThreadPool &pool) {
+
+    const size_t length = static_cast<size_t>(last - first);
+    if (length <= leaf_digits()) {
+        BigInteger leaf;
+        leaf.assign_decimal(first, last, false);
+        return leaf;
+    }
+
+    size_t level = 0;
+    while ((static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << (level + 1)) < length)
+        level++;
+    const char *middle = last - (static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << level);
+
+    BigInteger high, low;
+    if (length < TASK_DIGITS) {
+        high = parse_digits(first, middle, powers, pool);
+        low = parse_digits(middle, last, powers, pool);
+    } else {
+        future<BigInteger> task = pool.submit([first, middle, &powers, &pool]() {
+            return parse_digits(first, middle, powers, pool);
+        });
+        try {
+            low = parse_digits(middle, last, powers, pool);
+        } catch (...) {
+            task.wait();
+            throw;
+        }
+        high = pool.wait(task);
+    }
+
+    high *= *powers[level];
+    high += low;
+    return high;
+}
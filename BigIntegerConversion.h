@@ -0,0 +1,50 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "BigInteger.h"
+#include "BigIntegerPowerCache.h"
+#include "BigIntegerThreadPool.h"
+
+using std::string;
+using std::vector;
+
+
+// Decimal conversion of huge values on a thread pool. The value is split by the powers
+// of ten 10^(19 2^k) of BigIntegerPowerCache, shared by all parts, and the two halves
+// of every split are converted as separate tasks. Gives the same results as
+// BigInteger::to_string() and BigInteger(string), which stay single-threaded.
+class BigIntegerConversion {
+
+public:
+
+    // every part writes its digits straight into its own slice of one buffer
+    static string to_string(const BigInteger &, BigIntegerThreadPool & = BigIntegerThreadPool::shared());
+
+    static BigInteger parse(const string &, BigIntegerThreadPool & = BigIntegerThreadPool::shared());
+
+private:
+
+    // up to BigIntegerThresholds::CONVERSION_LEAF bytes a part is converted a word at a time,
+    // and up to as many digits as those bytes hold
+    static size_t leaf_digits();
+
+    // below these sizes a part is not worth a task of its own
+    static const int TASK_BYTES = 2048;
+    static const size_t TASK_DIGITS = 4864;
+
+    // powers[k] = 10^(19 2^k) for k < levels, the ones the cache has no room for kept in uncached
+    static vector<const BigInteger *> powers_of_ten(size_t levels, vector<BigInteger> &uncached);
+
+    // writes exactly 19 2^level digits of the magnitude, which is below 10^(19 2^level)
+    static void format(BigInteger magnitude, size_t level, const vector<const BigInteger *> &powers, char *digits,
+                       BigIntegerThreadPool &);
+
+    static BigInteger parse_digits(const char *first, const char *last, const vector<const BigInteger *> &powers,
+                                   BigIntegerThreadPool &);
+};
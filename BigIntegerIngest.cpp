@@ -0,0 +1,152 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <sstream>
+#include "BigIntegerChars.h"
+#include "BigIntegerIngest.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BIGINTEGER_MMAP
+#endif
+
+using std::future;
+
+const size_t BigIntegerIngest::TASK_BYTES;
+
+BigIntegerIngest::Result BigIntegerIngest::parse_chunk(const char *first, const char *last) {
+
+    // values start as copies of this one, so the shared count they detach from is not
+    // touched by other threads
+    const BigInteger zero;
+
+    Result result;
+    for (const char *line = first; line < last;) {
+        const char *end = static_cast<const char *>(std::memchr(line, '\n', static_cast<size_t>(last - line)));
+        const char *next = end == nullptr ? last : end + 1;
+        if (end == nullptr)
+            end = last;
+        if (end > line && *(end - 1) == '\r')
+            end--;
+
+        result.values.push_back(zero);
+        const BigIntegerChars::FromCharsResult read = BigIntegerChars::from_chars(line, end, result.values.back());
+        if (read.ec != std::errc() || read.ptr != end) {
+            const std::errc ec = read.ec != std::errc() ? read.ec : std::errc::invalid_argument;
+            result.errors.push_back({result.values.size() - 1, static_cast<size_t>(read.ptr - line), ec});
+            result.values.back() = zero;
+        }
+
+        line = next;
+    }
+    return result;
+}
+
+BigIntegerIngest::Result BigIntegerIngest::parse_lines(const char *first, const char *last,
+                                                       BigIntegerThreadPool &pool) {
+
+    // chunks of about TASK_BYTES, each ending right after a line end or at last
+    vector<const char *> bounds(1, first);
+    while (static_cast<size_t>(last - bounds.back()) > TASK_BYTES) {
+        const char *from = bounds.back() + TASK_BYTES;
+        const char *end = static_cast<const char *>(std::memchr(from, '\n', static_cast<size_t>(last - from)));
+        if (end == nullptr || end + 1 == last)
+            break;
+        bounds.push_back(end + 1);
+    }
+    bounds.push_back(last);
+
+    const size_t chunks = bounds.size() - 1;
+    vector<Result> parts(chunks);
+    vector<future<void>> tasks;
+    tasks.reserve(chunks - 1);
+    for (size_t i = 1; i < chunks; i++)
+        tasks.push_back(pool.submit([&parts, &bounds, i]() { parts[i] = parse_chunk(bounds[i], bounds[i + 1]); }));
+
+    // the tasks write parts and read bounds, so all of them finish before anything is thrown
+    try {
+        parts[0] = parse_chunk(bounds[0], bounds[1]);
+        for (future<void> &task : tasks)
+            pool.wait(task);
+    } catch (...) {
+        for (future<void> &task : tasks)
+            if (task.valid())
+                task.wait();
+        throw;
+    }
+
+    Result result = std::move(parts[0]);
+    size_t lines = 0;
+    for (size_t i = 1; i < chunks; i++)
+        lines += parts[i].values.size();
+    result.values.reserve(result.values.size() + lines);
+    for (size_t i = 1; i < chunks; i++) {
+        const size_t offset = result.values.size();
+        result.values.insert(result.values.end(), std::make_move_iterator(parts[i].values.begin()),
+                             std::make_move_iterator(parts[i].values.end()));
+        for (Error error : parts[i].errors) {
+            error.line += offset;
+            result.errors.push_back(error);
+        }
+    }
+
+    return result;
+}
+
+bool BigIntegerIngest::parse_file(const string &path, Result &result, BigIntegerThreadPool &pool) {
+
+#ifdef BIGINTEGER_MMAP
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+        ::close(descriptor);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(status.st_size);
+    if (size == 0) {
+        ::close(descriptor);
+        result = Result();
+        return true;
+    }
+
+    void *mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapped != MAP_FAILED) {
+        const char *text = static_cast<const char *>(mapped);
+        try {
+            result = parse_lines(text, text + size, pool);
+        } catch (...) {
+            ::munmap(mapped, size);
+            throw;
+        }
+        ::munmap(mapped, size);
+        return true;
+    }
+#endif
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    if (file.bad())
+        return false;
+
+    const string text = contents.str();
+    result = parse_lines(text.data(), text.data() + text.size(), pool);
+    return true;
+}
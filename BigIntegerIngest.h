@@ -0,0 +1,55 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "BigInteger.h"
+#include "BigIntegerThreadPool.h"
+
+using std::string;
+using std::vector;
+
+
+// Bulk parsing of text with one decimal number per line. The text is cut into chunks at
+// line ends, the chunks are parsed by separate tasks of a thread pool with
+// BigIntegerChars::from_chars, and their values are joined in the order of the text, so
+// the result does not depend on the threads. Invalid lines are reported, not thrown.
+class BigIntegerIngest {
+
+public:
+
+    struct Error {
+        // the line, counted from 0, and the character of it where the number went wrong
+        size_t line;
+        size_t column;
+        std::errc ec;
+    };
+
+    struct Result {
+        // one per line, 0 for invalid lines; a line end at the very end starts no new line
+        vector<BigInteger> values;
+        // in the order of the lines
+        vector<Error> errors;
+    };
+
+    // lines end with "\n" or "\r\n"; a line is an optional '-' and digits, nothing else
+    static Result parse_lines(const char *first, const char *last,
+                              BigIntegerThreadPool & = BigIntegerThreadPool::shared());
+
+    // the file is memory-mapped where the platform allows it, false if it cannot be read
+    static bool parse_file(const string &path, Result &, BigIntegerThreadPool & = BigIntegerThreadPool::shared());
+
+private:
+
+    // text of each task, cut at the next line end
+    static const size_t TASK_BYTES = 1 << 16;
+
+    // lines counted from 0 within the chunk
+    static Result parse_chunk(const char *first, const char *last);
+};
@@ -0,0 +1,508 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include "BigIntegerKernels.h"
+#include "BigIntegerAsync.h"
+#include "BigIntegerThresholds.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BIGINTEGER_KERNELS_BMI2
+#include <cpuid.h>
+#endif
+
+namespace mpn {
+
+    static limb mul_1_generic(limb *r, const limb *a, const size_t n, const limb b) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb high, low;
+            mul_words(a[i], b, high, low);
+            low += carry;
+            carry = high + (low < carry ? 1 : 0);
+            r[i] = low;
+        }
+        return carry;
+    }
+
+    static limb addmul_1_generic(limb *r, const limb *a, const size_t n, const limb b) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb high, low;
+            mul_words(a[i], b, high, low);
+            low += carry;
+            high += low < carry ? 1 : 0;
+            low += r[i];
+            high += low < r[i] ? 1 : 0;
+            r[i] = low;
+            carry = high;
+        }
+        return carry;
+    }
+
+#if defined(BIGINTEGER_KERNELS_BMI2)
+
+    // MULX leaves the flags alone, so ADCX adds the high limbs along the carry flag while ADOX
+    // adds r along the overflow flag; the loop takes four limbs and the rest goes first
+    static limb addmul_1_bmi2(limb *r, const limb *a, const size_t n, const limb b) {
+        const size_t head = n % 4;
+        limb carry = addmul_1_generic(r, a, head, b);
+        size_t blocks = n / 4;
+        if (blocks == 0)
+            return carry;
+        a += head;
+        r += head;
+        __asm__(
+        "xor %%r8d, %%r8d\n\t"
+        "1:\n\t"
+        "mulx (%[a]), %%r8, %%r9\n\t"
+        "adcx %[carry], %%r8\n\t"
+        "adox (%[r]), %%r8\n\t"
+        "mov %%r8, (%[r])\n\t"
+        "mulx 8(%[a]), %%r8, %[carry]\n\t"
+        "adcx %%r9, %%r8\n\t"
+        "adox 8(%[r]), %%r8\n\t"
+        "mov %%r8, 8(%[r])\n\t"
+        "mulx 16(%[a]), %%r8, %%r9\n\t"
+        "adcx %[carry], %%r8\n\t"
+        "adox 16(%[r]), %%r8\n\t"
+        "mov %%r8, 16(%[r])\n\t"
+        "mulx 24(%[a]), %%r8, %[carry]\n\t"
+        "adcx %%r9, %%r8\n\t"
+        "adox 24(%[r]), %%r8\n\t"
+        "mov %%r8, 24(%[r])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %%r8d\n\t"
+        "adcx %%r8, %[carry]\n\t"
+        "adox %%r8, %[carry]\n\t"
+        : [a] "+&r"(a), [r] "+&r"(r), [blocks] "+&c"(blocks), [carry] "+&r"(carry)
+        : "d"(b)
+        : "r8", "r9", "cc", "memory");
+        return carry;
+    }
+
+    static limb mul_1_bmi2(limb *r, const limb *a, const size_t n, const limb b) {
+        const size_t head = n % 4;
+        limb carry = mul_1_generic(r, a, head, b);
+        size_t blocks = n / 4;
+        if (blocks == 0)
+            return carry;
+        a += head;
+        r += head;
+        __asm__(
+        "xor %%r8d, %%r8d\n\t"
+        "1:\n\t"
+        "mulx (%[a]), %%r8, %%r9\n\t"
+        "adcx %[carry], %%r8\n\t"
+        "mov %%r8, (%[r])\n\t"
+        "mulx 8(%[a]), %%r8, %[carry]\n\t"
+        "adcx %%r9, %%r8\n\t"
+        "mov %%r8, 8(%[r])\n\t"
+        "mulx 16(%[a]), %%r8, %%r9\n\t"
+        "adcx %[carry], %%r8\n\t"
+        "mov %%r8, 16(%[r])\n\t"
+        "mulx 24(%[a]), %%r8, %[carry]\n\t"
+        "adcx %%r9, %%r8\n\t"
+        "mov %%r8, 24(%[r])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %%r8d\n\t"
+        "adcx %%r8, %[carry]\n\t"
+        : [a] "+&r"(a), [r] "+&r"(r), [blocks] "+&c"(blocks), [carry] "+&r"(carry)
+        : "d"(b)
+        : "r8", "r9", "cc", "memory");
+        return carry;
+    }
+
+    static bool has_bmi2() {
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+        return (ebx & bit_BMI2) != 0 && (ebx & bit_ADX) != 0;
+    }
+
+#endif
+
+    using Mul1 = limb (*)(limb *, const limb *, size_t, limb);
+
+    template<Mul1 MUL_1, Mul1 ADDMUL_1>
+    static void mul_basecase_with(limb *r, const limb *a, const size_t n, const limb *b, const size_t m) {
+        BigIntegerCheckpoint checkpoint;
+        r[n] = MUL_1(r, a, n, b[0]);
+        for (size_t i = 1; i < m; i++) {
+            checkpoint.step(i, m);
+            r[n + i] = ADDMUL_1(r + i, a, n, b[i]);
+        }
+    }
+
+    template<Mul1 ADDMUL_1>
+    static void sqr_basecase_with(limb *r, const limb *a, const size_t n) {
+
+        BigIntegerCheckpoint checkpoint;
+
+        // the products a[i] a[j] for i < j, doubled
+        std::fill(r, r + 2 * n, 0);
+        for (size_t i = 0; i + 1 < n; i++) {
+            checkpoint.step(i, n);
+            r[i + n] = ADDMUL_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
+        if (n > 1)
+            r[2 * n - 1] = lshift(r, r, 2 * n - 1, 1);
+
+        // and the squares on the diagonal
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb high, low;
+            mul_words(a[i], a[i], high, low);
+            low += carry;
+            high += low < carry ? 1 : 0;
+            r[2 * i] += low;
+            high += r[2 * i] < low ? 1 : 0;
+            r[2 * i + 1] += high;
+            carry = r[2 * i + 1] < high ? 1 : 0;
+        }
+    }
+
+    struct Variant {
+        const char *name;
+        bool (*supported)();
+        Mul1 mul_1;
+        Mul1 addmul_1;
+        void (*mul_basecase)(limb *, const limb *, size_t, const limb *, size_t);
+        void (*sqr_basecase)(limb *, const limb *, size_t);
+    };
+
+    static bool always() {
+        return true;
+    }
+
+    // the preferred first
+    static const Variant VARIANTS[] = {
+#if defined(BIGINTEGER_KERNELS_BMI2)
+            {"bmi2", has_bmi2, mul_1_bmi2, addmul_1_bmi2,
+                    mul_basecase_with<mul_1_bmi2, addmul_1_bmi2>, sqr_basecase_with<addmul_1_bmi2>},
+#endif
+            {"generic", always, mul_1_generic, addmul_1_generic,
+                    mul_basecase_with<mul_1_generic, addmul_1_generic>, sqr_basecase_with<addmul_1_generic>}
+    };
+
+    static std::atomic<const Variant *> selected(nullptr);
+
+    static const Variant *find_variant(const char *name) {
+        for (const Variant &variant : VARIANTS) {
+            if (std::strcmp(variant.name, name) == 0)
+                return variant.supported() ? &variant : nullptr;
+        }
+        return nullptr;
+    }
+
+    static const Variant &variant() {
+        const Variant *current = selected.load(std::memory_order_acquire);
+        if (current == nullptr) {
+            const char *forced = std::getenv("BIGINTEGER_KERNELS");
+            current = forced != nullptr ? find_variant(forced) : nullptr;
+            for (const Variant &candidate : VARIANTS) {
+                if (current == nullptr && candidate.supported())
+                    current = &candidate;
+            }
+            selected.store(current, std::memory_order_release);
+        }
+        return *current;
+    }
+
+    const char *kernels() {
+        return variant().name;
+    }
+
+    bool use_kernels(const char *name) {
+        const Variant *chosen = find_variant(name);
+        if (chosen != nullptr)
+            selected.store(chosen, std::memory_order_release);
+        return chosen != nullptr;
+    }
+
+    limb add_n(limb *r, const limb *a, const limb *b, const size_t n) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            const limb sum = a[i] + b[i];
+            const limb next = sum < b[i] ? 1 : 0;
+            r[i] = sum + carry;
+            carry = next + (r[i] < carry ? 1 : 0);
+        }
+        return carry;
+    }
+
+    limb add_1(limb *r, const limb *a, const size_t n, limb b) {
+        for (size_t i = 0; i < n; i++) {
+            r[i] = a[i] + b;
+            b = r[i] < b ? 1 : 0;
+        }
+        return b;
+    }
+
+    limb add(limb *r, const limb *a, const size_t n, const limb *b, const size_t m) {
+        return add_1(r + m, a + m, n - m, add_n(r, a, b, m));
+    }
+
+    limb sub_n(limb *r, const limb *a, const limb *b, const size_t n) {
+        limb borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            const limb x = a[i], y = b[i];
+            r[i] = x - y - borrow;
+            borrow = x < y || x - y < borrow ? 1 : 0;
+        }
+        return borrow;
+    }
+
+    limb sub_1(limb *r, const limb *a, const size_t n, limb b) {
+        for (size_t i = 0; i < n; i++) {
+            const limb x = a[i];
+            r[i] = x - b;
+            b = x < b ? 1 : 0;
+        }
+        return b;
+    }
+
+    limb sub(limb *r, const limb *a, const size_t n, const limb *b, const size_t m) {
+        return sub_1(r + m, a + m, n - m, sub_n(r, a, b, m));
+    }
+
+    limb mul_1(limb *r, const limb *a, const size_t n, const limb b) {
+        return variant().mul_1(r, a, n, b);
+    }
+
+    limb addmul_1(limb *r, const limb *a, const size_t n, const limb b) {
+        return variant().addmul_1(r, a, n, b);
+    }
+
+    limb submul_1(limb *r, const limb *a, const size_t n, const limb b) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb high, low;
+            mul_words(a[i], b, high, low);
+            low += carry;
+            high += low < carry ? 1 : 0;
+            const limb x = r[i];
+            r[i] = x - low;
+            carry = high + (x < low ? 1 : 0);
+        }
+        return carry;
+    }
+
+    void mul_basecase(limb *r, const limb *a, const size_t n, const limb *b, const size_t m) {
+        variant().mul_basecase(r, a, n, b, m);
+    }
+
+    void sqr_basecase(limb *r, const limb *a, const size_t n) {
+        variant().sqr_basecase(r, a, n);
+    }
+
+    size_t mul_scratch_size(const size_t n) {
+        return 8 * n + 2 * LIMB_BITS;
+    }
+
+    // a - b over n limbs as a magnitude in r, whether it is negative
+    static bool subtract_magnitude(limb *r, const limb *a, const size_t n, const limb *b, const size_t m) {
+        if (sub(r, a, n, b, m) == 0)
+            return false;
+        for (size_t i = 0; i < n; i++)
+            r[i] = ~r[i];
+        add_1(r, r, n, 1);
+        return true;
+    }
+
+    // r[h, size) += z0 + z2 - middle or + middle: the Karatsuba recombination with z0 = r[0, 2 h),
+    // z2 = r[2 h, size) and middle of 2 h limbs, t of 2 h + 1 limbs
+    static void add_middle(limb *r, const size_t size, const size_t h, const limb *middle, const bool subtract,
+                           limb *t) {
+        std::copy(r, r + 2 * h, t);
+        t[2 * h] = add(t, t, 2 * h, r + 2 * h, size - 2 * h);
+        if (subtract)
+            t[2 * h] -= sub_n(t, t, middle, 2 * h);
+        else
+            t[2 * h] += add_n(t, t, middle, 2 * h);
+        // the sum fits, so a top limb past the end of r is zero
+        add(r + h, r + h, size - h, t, std::min(2 * h + 1, size - h));
+    }
+
+    void mul(limb *r, const limb *a, const size_t n, const limb *b, const size_t m, limb *scratch) {
+
+        if (m < BigIntegerThresholds::get(BigIntegerThresholds::MUL_KARATSUBA)) {
+            mul_basecase(r, a, n, b, m);
+            return;
+        }
+
+        BigIntegerCheckpoint checkpoint;
+        const size_t h = (n + 1) / 2;
+
+        // unbalanced: blocks of m limbs of a, each product added in
+        if (h >= m) {
+            mul(r, a, m, b, m, scratch);
+            limb *t = scratch;
+            for (size_t i = m; i < n; i += m) {
+                checkpoint.step(i, n);
+                const size_t length = std::min(m, n - i);
+                if (length == m)
+                    mul(t, a + i, m, b, m, scratch + 2 * m);
+                else
+                    mul(t, b, m, a + i, length, scratch + 2 * m);
+                std::copy(t + m, t + m + length, r + i + m);
+                add_1(r + i + m, r + i + m, length, add_n(r + i, r + i, t, m));
+            }
+            return;
+        }
+
+        // a = a1 B^h + a0 and b = b1 B^h + b0, a0 b1 + a1 b0 = a0 b0 + a1 b1 - (a0 - a1)(b0 - b1)
+        limb *da = scratch;
+        limb *db = scratch + h;
+        limb *dm = scratch + 2 * h;
+        const bool negative = subtract_magnitude(da, a, h, a + h, n - h) != subtract_magnitude(db, b, h, b + h, m - h);
+
+        checkpoint.step(0, 3);
+        mul(dm, da, h, db, h, scratch + 4 * h);
+        checkpoint.step(1, 3);
+        mul(r, a, h, b, h, scratch + 4 * h);
+        checkpoint.step(2, 3);
+        mul(r + 2 * h, a + h, n - h, b + h, m - h, scratch + 4 * h);
+
+        add_middle(r, n + m, h, dm, !negative, scratch + 4 * h);
+    }
+
+    void sqr(limb *r, const limb *a, const size_t n, limb *scratch) {
+
+        if (n < BigIntegerThresholds::get(BigIntegerThresholds::SQR_KARATSUBA)) {
+            sqr_basecase(r, a, n);
+            return;
+        }
+
+        BigIntegerCheckpoint checkpoint;
+        const size_t h = (n + 1) / 2;
+
+        // 2 a0 a1 = a0^2 + a1^2 - (a0 - a1)^2
+        limb *d = scratch;
+        limb *dm = scratch + h;
+        subtract_magnitude(d, a, h, a + h, n - h);
+
+        checkpoint.step(0, 3);
+        sqr(dm, d, h, scratch + 3 * h);
+        checkpoint.step(1, 3);
+        sqr(r, a, h, scratch + 3 * h);
+        checkpoint.step(2, 3);
+        sqr(r + 2 * h, a + h, n - h, scratch + 3 * h);
+
+        add_middle(r, 2 * n, h, dm, true, scratch + 3 * h);
+    }
+
+    limb lshift(limb *r, const limb *a, const size_t n, const unsigned int shift) {
+        const limb out = a[n - 1] >> (LIMB_BITS - shift);
+        for (size_t i = n - 1; i > 0; i--)
+            r[i] = (a[i] << shift) | (a[i - 1] >> (LIMB_BITS - shift));
+        r[0] = a[0] << shift;
+        return out;
+    }
+
+    limb rshift(limb *r, const limb *a, const size_t n, const unsigned int shift) {
+        const limb out = a[0] << (LIMB_BITS - shift);
+        for (size_t i = 0; i + 1 < n; i++)
+            r[i] = (a[i] >> shift) | (a[i + 1] << (LIMB_BITS - shift));
+        r[n - 1] = a[n - 1] >> shift;
+        return out;
+    }
+
+    int cmp(const limb *a, const limb *b, size_t n) {
+        while (n-- > 0) {
+            if (a[n] != b[n])
+                return a[n] < b[n] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    size_t normalized_size(const limb *a, size_t n) {
+        while (n > 0 && a[n - 1] == 0)
+            n--;
+        return n;
+    }
+
+    limb divrem_1(limb *q, const limb *a, const size_t n, const limb d) {
+
+        const int shift = leading_zeros(d);
+        const limb normalized = d << shift;
+        const limb v = reciprocal(normalized);
+
+        limb remainder = 0;
+        for (size_t i = n; i-- > 0;) {
+            const limb word = a[i];
+            const limb high = shift == 0 ? remainder : (remainder << shift) | (word >> (LIMB_BITS - shift));
+            limb shifted_remainder;
+            q[i] = divide_words(high, word << shift, normalized, v, shifted_remainder);
+            remainder = shifted_remainder >> shift;
+        }
+        return remainder;
+    }
+
+    limb divrem(limb *q, limb *u, const size_t n, const limb *d, const size_t m) {
+
+        limb top = 0;
+        if (cmp(u + n - m, d, m) >= 0) {
+            sub_n(u + n - m, u + n - m, d, m);
+            top = 1;
+        }
+
+        const limb dh = d[m - 1];
+        const limb inverse = reciprocal(dh);
+
+        BigIntegerCheckpoint checkpoint;
+        for (size_t j = n - m; j-- > 0;) {
+
+            checkpoint.step(n - m - 1 - j, n - m);
+
+            // u[j, j + m] is below d B, the estimate from its top two limbs is at most two too large
+            limb q_hat, r_hat;
+            bool r_hat_overflow = false;
+            if (u[j + m] >= dh) {
+                q_hat = ~static_cast<limb>(0);
+                r_hat = u[j + m - 1] + dh;
+                r_hat_overflow = r_hat < dh;
+            } else {
+                q_hat = divide_words(u[j + m], u[j + m - 1], dh, inverse, r_hat);
+            }
+            while (m > 1 && !r_hat_overflow) {
+                limb high, low;
+                mul_words(q_hat, d[m - 2], high, low);
+                if (high < r_hat || (high == r_hat && low <= u[j + m - 2]))
+                    break;
+                q_hat--;
+                r_hat += dh;
+                r_hat_overflow = r_hat < dh;
+            }
+
+            const limb borrow = submul_1(u + j, d, m, q_hat);
+            const limb word = u[j + m];
+            u[j + m] = word - borrow;
+
+            // rarely the estimate is still one too large, add the divisor back
+            if (word < borrow) {
+                q_hat--;
+                u[j + m] += add_n(u + j, u + j, d, m);
+            }
+            q[j] = q_hat;
+        }
+
+        return top;
+    }
+}
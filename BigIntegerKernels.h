@@ -0,0 +1,157 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+// Kernels on spans of 64-bit limbs, the least significant first, in caller-owned buffers.
+// None of them allocates; carries and borrows are returned as limbs. Unless said otherwise
+// the result may be the same span as an operand, but must not partly overlap it.
+namespace mpn {
+
+    using limb = uint64_t;
+
+    const int LIMB_BITS = 64;
+
+    inline void mul_words(const limb a, const limb b, limb &high, limb &low) {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<limb>(product >> 64);
+        low = static_cast<limb>(product);
+#else
+        const limb a_low = a & 0xFFFFFFFFu, a_high = a >> 32;
+        const limb b_low = b & 0xFFFFFFFFu, b_high = b >> 32;
+        const limb low_low = a_low * b_low, low_high = a_low * b_high;
+        const limb high_low = a_high * b_low, high_high = a_high * b_high;
+        const limb middle = (low_low >> 32) + (low_high & 0xFFFFFFFFu) + (high_low & 0xFFFFFFFFu);
+        low = (middle << 32) | (low_low & 0xFFFFFFFFu);
+        high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
+    }
+
+    // of a non-zero limb
+    inline int leading_zeros(limb a) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(a);
+#else
+        int count = 0;
+        for (; (a & (static_cast<limb>(1) << 63)) == 0; a <<= 1)
+            count++;
+        return count;
+#endif
+    }
+
+    // floor((2^128 - 1) / d) - 2^64 for d with the top bit set, see Moller and Granlund,
+    // "Improved division by invariant integers"
+    inline limb reciprocal(const limb d) {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<limb>(((static_cast<unsigned __int128>(~d) << 64) | ~static_cast<limb>(0)) / d);
+#else
+        limb remainder = ~d;
+        limb quotient = 0;
+        for (int i = 63; i >= 0; i--) {
+            const bool overflow = (remainder >> 63) != 0;
+            remainder = (remainder << 1) | 1u;
+            quotient <<= 1;
+            if (overflow || remainder >= d) {
+                remainder -= d;
+                quotient |= 1u;
+            }
+        }
+        return quotient;
+#endif
+    }
+
+    // (high, low) / d with high < d, d normalized and v = reciprocal(d): two multiplications, no division
+    inline limb divide_words(const limb high, const limb low, const limb d, const limb v, limb &remainder) {
+        limb q_high, q_low;
+        mul_words(v, high, q_high, q_low);
+        q_low += low;
+        q_high += high + 1 + (q_low < low ? 1 : 0);
+        limb r = low - q_high * d;
+        if (r > q_low) {
+            q_high--;
+            r += d;
+        }
+        if (r >= d) {
+            q_high++;
+            r -= d;
+        }
+        remainder = r;
+        return q_high;
+    }
+
+    // the variant of mul_1, addmul_1, mul_basecase and sqr_basecase in use: "bmi2" on x86-64
+    // processors with BMI2 and ADX, else "generic"; chosen on the first call unless the
+    // environment variable BIGINTEGER_KERNELS names a variant the processor supports
+    const char *kernels();
+
+    // switches to the named variant, false if it is unknown or the processor lacks it
+    bool use_kernels(const char *name);
+
+    // r[0, n) = a + b, the carry returned
+    limb add_n(limb *r, const limb *a, const limb *b, size_t n);
+
+    limb add_1(limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n) = a[0, n) + b[0, m), n >= m
+    limb add(limb *r, const limb *a, size_t n, const limb *b, size_t m);
+
+    // r[0, n) = a - b, the borrow returned
+    limb sub_n(limb *r, const limb *a, const limb *b, size_t n);
+
+    limb sub_1(limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n) = a[0, n) - b[0, m), n >= m
+    limb sub(limb *r, const limb *a, size_t n, const limb *b, size_t m);
+
+    // r[0, n) = a * b, the high limb returned
+    limb mul_1(limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n) += a * b, the high limb returned
+    limb addmul_1(limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n) -= a * b, the limb to subtract from r[n] returned
+    limb submul_1(limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n + m) = a[0, n) * b[0, m), n >= m >= 1, r apart from a and b
+    void mul_basecase(limb *r, const limb *a, size_t n, const limb *b, size_t m);
+
+    // r[0, 2 n) = a[0, n)^2, r apart from a
+    void sqr_basecase(limb *r, const limb *a, size_t n);
+
+    // limbs of scratch mul() and sqr() need for operands of up to n limbs
+    size_t mul_scratch_size(size_t n);
+
+    // as mul_basecase, Karatsuba from BigIntegerThresholds::MUL_KARATSUBA limbs
+    void mul(limb *r, const limb *a, size_t n, const limb *b, size_t m, limb *scratch);
+
+    // as sqr_basecase, Karatsuba from BigIntegerThresholds::SQR_KARATSUBA limbs
+    void sqr(limb *r, const limb *a, size_t n, limb *scratch);
+
+    // r[0, n) = a << shift for 0 < shift < 64, the bits shifted out returned in the low bits;
+    // r may start above a
+    limb lshift(limb *r, const limb *a, size_t n, unsigned int shift);
+
+    // r[0, n) = a >> shift for 0 < shift < 64, the bits shifted out returned in the high bits;
+    // r may start below a
+    limb rshift(limb *r, const limb *a, size_t n, unsigned int shift);
+
+    int cmp(const limb *a, const limb *b, size_t n);
+
+    // n without the high zero limbs
+    size_t normalized_size(const limb *a, size_t n);
+
+    // q[0, n) = a[0, n) / d for any non-zero d, the remainder returned; q may be a
+    limb divrem_1(limb *q, const limb *a, size_t n, limb d);
+
+    // divides u[0, n) by d[0, m), n >= m >= 1, with the top bit of d[m - 1] set: q[0, n - m)
+    // takes the quotient but its top limb, which is returned, and u[0, m) the remainder;
+    // Knuth, "The Art of Computer Programming", vol. 2, 4.3.1, algorithm D
+    limb divrem(limb *q, limb *u, size_t n, const limb *d, size_t m);
+}
@@ -0,0 +1,106 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <atomic>
+#include <mutex>
+#include "BigIntegerPowerCache.h"
+
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+
+static const uint64_t TEN_TO_DIGITS_IN_WORD = 10000000000000000000ull;
+
+const unsigned int BigIntegerPowerCache::MAX_LEVELS;
+
+// zero-initialized before any dynamic initialization, so usable from static constructors
+static atomic<const BigInteger *> levels[BigIntegerPowerCache::MAX_LEVELS];
+static atomic<size_t> memory_limit(static_cast<size_t>(64) << 20);
+static atomic<size_t> memory(0);
+static mutex writer;
+
+// a decimal digit takes less than 5/12 of a byte
+static size_t level_bytes(const unsigned int level) {
+    return (static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << level) * 5 / 12 + 1;
+}
+
+const BigInteger *BigIntegerPowerCache::level(const unsigned int level) {
+
+    if (level >= MAX_LEVELS)
+        return nullptr;
+
+    const BigInteger *cached = levels[level].load(std::memory_order_acquire);
+    if (cached != nullptr)
+        return cached;
+
+    lock_guard<mutex> guard(writer);
+
+    // either every missing level up to this one fits, or none is computed
+    size_t needed = memory.load(std::memory_order_relaxed);
+    for (unsigned int k = 0; k <= level; k++)
+        if (levels[k].load(std::memory_order_relaxed) == nullptr)
+            needed += level_bytes(k);
+    if (needed > memory_limit.load(std::memory_order_relaxed))
+        return nullptr;
+
+    for (unsigned int k = 0; k <= level; k++) {
+        if (levels[k].load(std::memory_order_relaxed) != nullptr)
+            continue;
+
+        BigInteger *power = new BigInteger(1);
+        if (k == 0) {
+            *power *= TEN_TO_DIGITS_IN_WORD;
+        } else {
+            const BigInteger *previous = levels[k - 1].load(std::memory_order_relaxed);
+            *power = *previous * *previous;
+        }
+        memory.fetch_add(static_cast<size_t>(power->capacity()), std::memory_order_relaxed);
+        levels[k].store(power, std::memory_order_release);
+    }
+
+    return levels[level].load(std::memory_order_relaxed);
+}
+
+BigInteger BigIntegerPowerCache::power_of_ten(const unsigned int exponent) {
+
+    uint64_t low = 1;
+    for (unsigned int i = 0; i < exponent % BigInteger::DIGITS_IN_WORD; i++)
+        low *= 10;
+    BigInteger ans(1);
+    ans *= low;
+
+    // the levels over the memory limit are squared here and dropped afterwards
+    BigInteger uncached;
+    const BigInteger *power = nullptr;
+    for (unsigned int k = 0, rest = exponent / BigInteger::DIGITS_IN_WORD; rest != 0; k++, rest >>= 1) {
+        const BigInteger *cached = level(k);
+        if (cached != nullptr) {
+            power = cached;
+        } else {
+            uncached = power == nullptr ? BigInteger(1) * TEN_TO_DIGITS_IN_WORD : *power * *power;
+            power = &uncached;
+        }
+        if ((rest & 1u) != 0)
+            ans *= *power;
+    }
+
+    return ans;
+}
+
+void BigIntegerPowerCache::warm_up(const size_t digits) {
+    for (unsigned int k = 0; (static_cast<size_t>(BigInteger::DIGITS_IN_WORD) << k) < digits; k++)
+        if (level(k) == nullptr)
+            return;
+}
+
+void BigIntegerPowerCache::set_memory_limit(const size_t bytes) {
+    lock_guard<mutex> guard(writer);
+    memory_limit.store(bytes, std::memory_order_relaxed);
+}
+
+size_t BigIntegerPowerCache::memory_used() {
+    return memory.load(std::memory_order_relaxed);
+}
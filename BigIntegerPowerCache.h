@@ -0,0 +1,35 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstddef>
+#include "BigInteger.h"
+
+
+// Process-wide table of the powers 10^(19 2^k) shared by decimal conversions and
+// power(10, n). Levels are computed on first use under a lock and published atomically,
+// readers of a published level take no lock. Published levels are never freed, and
+// stop being added once they would exceed the memory limit.
+class BigIntegerPowerCache {
+
+public:
+
+    static const unsigned int MAX_LEVELS = 40;
+
+    // 10^(19 2^level), nullptr when the level does not fit into the memory limit
+    static const BigInteger *level(unsigned int);
+
+    // 10^exponent built from the cached levels
+    static BigInteger power_of_ten(unsigned int exponent);
+
+    // computes the levels a conversion of this many decimal digits splits by
+    static void warm_up(size_t digits);
+
+    // bytes the levels may take, 64 MiB by default; lowering it keeps the levels already there
+    static void set_memory_limit(size_t bytes);
+
+    static size_t memory_used();
+};
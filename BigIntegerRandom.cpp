@@ -0,0 +1,29 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include "BigIntegerKernels.h"
+#include "BigIntegerRandom.h"
+
+vector<uint64_t> BigIntegerRandom::bound_words(const BigInteger &bound) {
+    if (bound <= BigInteger::ZERO)
+        throw BigInteger::BigIntegerException("Bound is not positive");
+    return BigInteger::magnitude_words(bound);
+}
+
+uint64_t BigIntegerRandom::mask_of(const uint64_t word) {
+    return ~static_cast<uint64_t>(0) >> mpn::leading_zeros(word);
+}
+
+bool BigIntegerRandom::below(const vector<uint64_t> &words, const vector<uint64_t> &limit) {
+    return mpn::cmp(words.data(), limit.data(), limit.size()) < 0;
+}
+
+void BigIntegerRandom::assign(BigInteger &value, const vector<uint64_t> &words) {
+    if (words.empty())
+        value = BigInteger::ZERO;
+    else
+        value.assign_words(words.data(), words.size(), false);
+}
@@ -0,0 +1,101 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "BigInteger.h"
+
+using std::vector;
+
+
+// Uniformly distributed non-negative BigIntegers drawn from any standard
+// UniformRandomBitGenerator. The generator fills 64-bit words, which go into the value in one
+// step; nothing is parsed. The fill_ variants draw a whole batch, reusing the buffers of the
+// values they overwrite and one set of words for all of them.
+class BigIntegerRandom {
+
+public:
+
+    // uniform in [0, 2^bits)
+    template<typename URBG>
+    static BigInteger random_bits(const unsigned int bits, URBG &generator) {
+        BigInteger value;
+        vector<uint64_t> words;
+        next_bits(value, bits, generator, words);
+        return value;
+    }
+
+    // uniform in [0, bound), throws for a bound that is not positive
+    template<typename URBG>
+    static BigInteger random_below(const BigInteger &bound, URBG &generator) {
+        BigInteger value;
+        const vector<uint64_t> limit = bound_words(bound);
+        vector<uint64_t> words;
+        next_below(value, limit, generator, words);
+        return value;
+    }
+
+    template<typename URBG>
+    static void fill_bits(vector<BigInteger> &values, const unsigned int bits, URBG &generator) {
+        vector<uint64_t> words;
+        for (BigInteger &value : values)
+            next_bits(value, bits, generator, words);
+    }
+
+    template<typename URBG>
+    static void fill_below(vector<BigInteger> &values, const BigInteger &bound, URBG &generator) {
+        const vector<uint64_t> limit = bound_words(bound);
+        vector<uint64_t> words;
+        for (BigInteger &value : values)
+            next_below(value, limit, generator, words);
+    }
+
+private:
+
+    // the little-endian words of a positive bound
+    static vector<uint64_t> bound_words(const BigInteger &);
+
+    // the bits up to the highest set one of a non-zero word
+    static uint64_t mask_of(uint64_t);
+
+    static bool below(const vector<uint64_t> &words, const vector<uint64_t> &limit);
+
+    static void assign(BigInteger &, const vector<uint64_t> &words);
+
+    template<typename URBG>
+    static void next_bits(BigInteger &value, const unsigned int bits, URBG &generator, vector<uint64_t> &words) {
+        std::uniform_int_distribution<uint64_t> word;
+        words.resize((bits + 63) / 64);
+        for (uint64_t &w : words)
+            w = word(generator);
+        if (bits % 64 != 0)
+            words.back() &= (static_cast<uint64_t>(1) << (bits % 64)) - 1;
+        assign(value, words);
+    }
+
+    // rejection sampling decided by the top word alone, unless it equals the one of the limit;
+    // as the top words have the same highest bit, at most every second one is rejected
+    template<typename URBG>
+    static void next_below(BigInteger &value, const vector<uint64_t> &limit, URBG &generator,
+                           vector<uint64_t> &words) {
+        std::uniform_int_distribution<uint64_t> word;
+        const size_t top = limit.size() - 1;
+        const uint64_t mask = mask_of(limit[top]);
+        words.resize(limit.size());
+        for (;;) {
+            words[top] = word(generator) & mask;
+            if (words[top] > limit[top])
+                continue;
+            for (size_t i = 0; i < top; i++)
+                words[i] = word(generator);
+            if (words[top] < limit[top] || below(words, limit))
+                break;
+        }
+        assign(value, words);
+    }
+};
@@ -0,0 +1,331 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include "BigIntegerReference.h"
+
+namespace reference {
+
+    static Byte filler(const Number &a) {
+        return a.neg ? BigInteger::MAX_BYTE : BigInteger::MIN_BYTE;
+    }
+
+    // i-th byte counting from the least significant one, sign-extended beyond the size
+    static Byte byte_at(const Number &a, const size_t i) {
+        return i < a.bytes.size() ? a.bytes[a.bytes.size() - 1 - i] : filler(a);
+    }
+
+    static Number from_bits(const vector<bool> &bits, const bool neg) {
+        Number a;
+        a.neg = neg;
+        a.bytes.assign(bits.size() / BigInteger::BITS_IN_BYTE + 1, 0);
+        for (size_t i = 0; i < bits.size(); i++)
+            if (bits[i])
+                a.bytes[a.bytes.size() - 1 - i / BigInteger::BITS_IN_BYTE] |= static_cast<Byte>(1u << (i % 8));
+        if (neg)
+            for (size_t i = bits.size(); i < a.bytes.size() * BigInteger::BITS_IN_BYTE; i++)
+                a.bytes[a.bytes.size() - 1 - i / BigInteger::BITS_IN_BYTE] |= static_cast<Byte>(1u << (i % 8));
+        return normalize(a);
+    }
+
+    static Number abs(const Number &a) {
+        return a.neg ? negate(a) : a;
+    }
+
+    static bool is_zero(const Number &a) {
+        Number n = normalize(a);
+        return !n.neg && n.bytes.size() == 1 && n.bytes[0] == 0;
+    }
+
+    Number Access::read(const BigInteger &a) {
+        Number n;
+        n.neg = a._neg;
+        n.bytes.assign(a.begin(), a.end());
+        return normalize(n);
+    }
+
+    bool Access::normalized(const BigInteger &a) {
+        Number n;
+        n.neg = a._neg;
+        n.bytes.assign(a.begin(), a.end());
+        return n.bytes == normalize(n).bytes;
+    }
+
+    BigInteger Access::write(const Number &n) {
+        Number normalized = normalize(n);
+        BigInteger a;
+        BigInteger::release(a._bytes);
+        a._neg = normalized.neg;
+        a._size = static_cast<int>(normalized.bytes.size());
+        a._capacity = a._size;
+        a._bytes = BigInteger::allocate(a._capacity);
+        std::copy(normalized.bytes.begin(), normalized.bytes.end(), a._bytes);
+        return a;
+    }
+
+    // drops the leading bytes BigInteger::normalize() drops: zeros of a positive number,
+    // 0xFF of a negative one while the sign stays in the next byte
+    Number normalize(Number a) {
+        if (a.bytes.empty())
+            a.bytes.push_back(filler(a));
+        size_t redundant = 0;
+        while (redundant + 1 < a.bytes.size() && a.bytes[redundant] == filler(a)
+               && (!a.neg || (a.bytes[redundant + 1] & 0x80u) != 0))
+            redundant++;
+        a.bytes.erase(a.bytes.begin(), a.bytes.begin() + redundant);
+        if (a.neg && (a.bytes[0] & 0x80u) == 0)
+            a.bytes.insert(a.bytes.begin(), filler(a));
+        return a;
+    }
+
+    bool equal(const Number &a, const Number &b) {
+        Number na = normalize(a), nb = normalize(b);
+        return na.neg == nb.neg && na.bytes == nb.bytes;
+    }
+
+    bool get_bit(const Number &a, const unsigned long i) {
+        return (byte_at(a, i / BigInteger::BITS_IN_BYTE) >> (i % BigInteger::BITS_IN_BYTE)) & 1u;
+    }
+
+    Number from_long(const long value) {
+        Number a;
+        a.neg = value < 0;
+        unsigned long n = static_cast<unsigned long>(value);
+        for (int i = 0; i < BigInteger::BYTES_IN_LONG; i++) {
+            a.bytes.insert(a.bytes.begin(), static_cast<Byte>(n & 0xFFu));
+            n >>= 8;
+        }
+        return normalize(a);
+    }
+
+    Number from_unsigned(const unsigned long value) {
+        Number a;
+        a.neg = false;
+        unsigned long n = value;
+        for (int i = 0; i < BigInteger::BYTES_IN_LONG; i++) {
+            a.bytes.insert(a.bytes.begin(), static_cast<Byte>(n & 0xFFu));
+            n >>= 8;
+        }
+        return normalize(a);
+    }
+
+    // halves the decimal string, collecting the remainders as bits
+    Number from_string(const string &number) {
+
+        if (number.empty())
+            throw BigInteger::BigIntegerException("Empty string parameter");
+
+        string digits = number;
+        bool neg = false;
+        if (digits[0] == '-') {
+            digits[0] = '0';
+            neg = true;
+        }
+        for (char ch : digits)
+            if (ch < '0' || ch > '9')
+                throw BigInteger::BigIntegerException("Illegal string parameter");
+
+        vector<bool> bits;
+        bool is_zero;
+        do {
+            bits.push_back((digits.back() - '0') % 2 == 1);
+            int remainder = 0;
+            is_zero = true;
+            for (char &ch : digits) {
+                int digit = ch - '0';
+                ch = static_cast<char>('0' + digit / 2 + remainder);
+                if (ch != '0')
+                    is_zero = false;
+                remainder = digit % 2 * 5;
+            }
+        } while (!is_zero);
+
+        Number a = from_bits(bits, false);
+        return neg ? negate(a) : a;
+    }
+
+    // divides the magnitude by ten byte by byte, one digit per pass
+    string to_string(const Number &a) {
+
+        Number magnitude = abs(a);
+        vector<Byte> bytes = magnitude.bytes;
+        string reversed;
+
+        bool zero;
+        do {
+            zero = true;
+            unsigned int remainder = 0;
+            for (Byte &byte : bytes) {
+                remainder = remainder * BigInteger::BYTE + byte;
+                byte = static_cast<Byte>(remainder / 10);
+                if (byte != 0)
+                    zero = false;
+                remainder %= 10;
+            }
+            reversed += static_cast<char>('0' + remainder);
+        } while (!zero);
+
+        if (a.neg && !is_zero(a))
+            reversed += '-';
+        return string(reversed.rbegin(), reversed.rend());
+    }
+
+    Number negate(const Number &a) {
+        Number inverted;
+        inverted.neg = !a.neg;
+        inverted.bytes.push_back(static_cast<Byte>(~filler(a)));
+        for (Byte byte : a.bytes)
+            inverted.bytes.push_back(static_cast<Byte>(~byte));
+        Number result = add(inverted, from_long(1));
+        return normalize(result);
+    }
+
+    Number add(const Number &a, const Number &b) {
+        size_t n = std::max(a.bytes.size(), b.bytes.size()) + 1;
+        Number sum;
+        sum.bytes.assign(n, 0);
+        unsigned int carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            carry += byte_at(a, i) + byte_at(b, i);
+            sum.bytes[n - 1 - i] = static_cast<Byte>(carry & 0xFFu);
+            carry >>= 8;
+        }
+        sum.neg = (sum.bytes[0] & 0x80u) != 0;
+        return normalize(sum);
+    }
+
+    Number subtract(const Number &a, const Number &b) {
+        return add(a, negate(b));
+    }
+
+    Number shift_left(const Number &a, const unsigned int shift) {
+        unsigned long bits = a.bytes.size() * BigInteger::BITS_IN_BYTE + shift;
+        vector<bool> result(bits);
+        for (unsigned long i = shift; i < bits; i++)
+            result[i] = get_bit(a, i - shift);
+        return from_bits(result, a.neg);
+    }
+
+    Number shift_right(const Number &a, const unsigned int shift) {
+        unsigned long bits = a.bytes.size() * BigInteger::BITS_IN_BYTE;
+        vector<bool> result(bits);
+        for (unsigned long i = 0; i < bits; i++)
+            result[i] = get_bit(a, i + shift);
+        return from_bits(result, a.neg);
+    }
+
+    int compare(const Number &a, const Number &b) {
+        if (a.neg != b.neg)
+            return a.neg ? -1 : 1;
+        Number na = normalize(a), nb = normalize(b);
+        if (na.bytes.size() != nb.bytes.size()) {
+            bool longer = na.bytes.size() > nb.bytes.size();
+            return longer != a.neg ? 1 : -1;
+        }
+        for (size_t i = 0; i < na.bytes.size(); i++)
+            if (na.bytes[i] != nb.bytes[i])
+                return na.bytes[i] > nb.bytes[i] ? 1 : -1;
+        return 0;
+    }
+
+    // shift-and-add over the bits of the second magnitude
+    Number multiply(const Number &a, const Number &b) {
+        Number shifted = abs(a);
+        Number multiplier = abs(b);
+        Number product = from_long(0);
+
+        unsigned long bits = multiplier.bytes.size() * BigInteger::BITS_IN_BYTE;
+        for (unsigned long i = 0; i < bits; i++) {
+            if (get_bit(multiplier, i))
+                product = add(product, shifted);
+            shifted = shift_left(shifted, 1);
+        }
+
+        return a.neg != b.neg ? negate(product) : product;
+    }
+
+    // restoring bit-by-bit division: floor(a / |b|), negated for a negative b,
+    // which keeps the remainder in [0, |b|) like BigInteger::operator/=
+    Number divide(const Number &a, const Number &b) {
+
+        if (is_zero(b))
+            throw BigInteger::BigIntegerException("Division by zero");
+
+        Number dividend = abs(a);
+        Number divisor = abs(b);
+
+        unsigned long bits = dividend.bytes.size() * BigInteger::BITS_IN_BYTE;
+        vector<bool> quotient(bits);
+        Number remainder = from_long(0);
+
+        for (unsigned long i = bits; i-- > 0;) {
+            remainder = shift_left(remainder, 1);
+            if (get_bit(dividend, i))
+                remainder = add(remainder, from_long(1));
+            if (compare(remainder, divisor) >= 0) {
+                remainder = subtract(remainder, divisor);
+                quotient[i] = true;
+            }
+        }
+
+        Number q = from_bits(quotient, false);
+        if (a.neg)
+            q = negate(is_zero(remainder) ? q : add(q, from_long(1)));
+        return b.neg ? negate(q) : q;
+    }
+
+    Number power(const Number &a, const unsigned int m) {
+        Number result = from_long(1);
+        Number multiplier = a;
+        for (unsigned int n = m; n > 0; n /= 2) {
+            if (n % 2 == 1)
+                result = multiply(result, multiplier);
+            if (n > 1)
+                multiplier = multiply(multiplier, multiplier);
+        }
+        return result;
+    }
+
+    // bit by bit over one bit more than the longer operand, the rest is the sign
+    template<typename Operation>
+    static Number bitwise(const Number &a, const Number &b, Operation operation) {
+        unsigned long bits = (std::max(a.bytes.size(), b.bytes.size()) + 1) * BigInteger::BITS_IN_BYTE;
+        vector<bool> result(bits);
+        for (unsigned long i = 0; i < bits; i++)
+            result[i] = operation(get_bit(a, i), get_bit(b, i));
+        return from_bits(result, operation(a.neg, b.neg));
+    }
+
+    Number bitwise_and(const Number &a, const Number &b) {
+        return bitwise(a, b, [](bool x, bool y) { return x && y; });
+    }
+
+    Number bitwise_or(const Number &a, const Number &b) {
+        return bitwise(a, b, [](bool x, bool y) { return x || y; });
+    }
+
+    Number bitwise_xor(const Number &a, const Number &b) {
+        return bitwise(a, b, [](bool x, bool y) { return x != y; });
+    }
+
+    Number bitwise_not(const Number &a) {
+        return subtract(negate(a), from_long(1));
+    }
+
+    unsigned int popcount(const Number &a) {
+        unsigned int count = 0;
+        for (unsigned long i = 0; i < a.bytes.size() * BigInteger::BITS_IN_BYTE; i++)
+            count += get_bit(a, i) != a.neg;
+        return count;
+    }
+
+    unsigned int bit_length(const Number &a) {
+        unsigned int length = static_cast<unsigned int>(a.bytes.size()) * BigInteger::BITS_IN_BYTE;
+        while (length > 0 && get_bit(a, length - 1) == a.neg)
+            length--;
+        return length;
+    }
+}
@@ -0,0 +1,83 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "BigInteger.h"
+
+using std::string;
+using std::vector;
+
+
+// Slow byte/bit algorithms kept as an oracle for the fast paths of BigInteger.
+// They work on their own copy of the bytes and never call BigInteger arithmetic,
+// so a broken kernel cannot hide by breaking its reference the same way.
+namespace reference {
+
+    // two's complement bytes, the most significant first, same layout as BigInteger:
+    // the sign is kept in neg, a positive number may have its top bit set
+    struct Number {
+        bool neg;
+        vector<Byte> bytes;
+    };
+
+    class Access {
+
+    public:
+
+        static Number read(const BigInteger &);
+
+        static BigInteger write(const Number &);
+
+        // whether the bytes are as short as BigInteger::normalize() leaves them
+        static bool normalized(const BigInteger &);
+    };
+
+    Number normalize(Number);
+
+    bool equal(const Number &, const Number &);
+
+    bool get_bit(const Number &, unsigned long);
+
+    Number from_long(long);
+
+    Number from_unsigned(unsigned long);
+
+    Number from_string(const string &);
+
+    string to_string(const Number &);
+
+    Number negate(const Number &);
+
+    Number add(const Number &, const Number &);
+
+    Number subtract(const Number &, const Number &);
+
+    Number multiply(const Number &, const Number &);
+
+    Number divide(const Number &, const Number &);
+
+    Number shift_left(const Number &, unsigned int);
+
+    Number shift_right(const Number &, unsigned int);
+
+    int compare(const Number &, const Number &);
+
+    Number power(const Number &, unsigned int);
+
+    Number bitwise_and(const Number &, const Number &);
+
+    Number bitwise_or(const Number &, const Number &);
+
+    Number bitwise_xor(const Number &, const Number &);
+
+    Number bitwise_not(const Number &);
+
+    unsigned int popcount(const Number &);
+
+    unsigned int bit_length(const Number &);
+}
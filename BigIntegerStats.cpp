@@ -0,0 +1,262 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include "BigIntegerStats.h"
+
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::vector;
+
+struct BigIntegerStats::Counters {
+
+    atomic<uint64_t> values[VALUES_COUNT];
+
+    Counters() {
+        for (atomic<uint64_t> &value : values)
+            value.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct BigIntegerStats::Registry {
+    mutex lock;
+    vector<Counters *> live;
+    Counters retired;
+    Snapshot baseline{};
+};
+
+// never destroyed, threads may still count while statics are torn down
+BigIntegerStats::Registry &BigIntegerStats::registry() {
+    static Registry *instance = new Registry();
+    return *instance;
+}
+
+BigIntegerStats::Counters *BigIntegerStats::thread_counters() {
+
+    struct Reaper {
+        Counters **counters = nullptr;
+        bool *finished = nullptr;
+
+        ~Reaper() {
+            if (counters == nullptr || *counters == nullptr)
+                return;
+            Registry &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            for (int i = 0; i < VALUES_COUNT; i++)
+                r.retired.values[i].fetch_add((*counters)->values[i].load(std::memory_order_relaxed),
+                                              std::memory_order_relaxed);
+            for (vector<Counters *>::iterator it = r.live.begin(); it != r.live.end(); ++it) {
+                if (*it == *counters) {
+                    r.live.erase(it);
+                    break;
+                }
+            }
+            delete *counters;
+            *counters = nullptr;
+            *finished = true;
+        }
+    };
+
+    static thread_local Counters *counters = nullptr;
+    static thread_local bool finished = false;
+    static thread_local Reaper reaper;
+
+    if (counters != nullptr)
+        return counters;
+    if (finished)
+        return &registry().retired;
+
+    counters = new Counters();
+    {
+        Registry &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        r.live.push_back(counters);
+    }
+    reaper.counters = &counters;
+    reaper.finished = &finished;
+    return counters;
+}
+
+static int histogram_bucket(uint64_t bytes) {
+    int bucket = 0;
+    while (bytes > 0 && bucket < BigIntegerStats::HISTOGRAM_BUCKETS - 1) {
+        bytes >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// a thread's own counters are written by it alone, so a relaxed load and store add to them
+// without a locked read-modify-write, and readers still see whole values; the retired block
+// is shared by the threads that have finished and needs real atomic additions
+static void count(atomic<uint64_t> &value, const uint64_t amount, const bool owned) {
+    if (owned)
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    else
+        value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+void BigIntegerStats::record(const Operation operation, const uint64_t bytes, const uint64_t nanoseconds) {
+    Counters *counters = thread_counters();
+    const bool owned = counters != &registry().retired;
+    atomic<uint64_t> *values = counters->values + operation * VALUES_PER_OPERATION;
+    count(values[0], 1, owned);
+    count(values[1], bytes, owned);
+    count(values[2], nanoseconds, owned);
+    count(values[3 + histogram_bucket(bytes)], 1, owned);
+}
+
+void BigIntegerStats::record_allocation(const uint64_t bytes) {
+    Counters *counters = thread_counters();
+    const bool owned = counters != &registry().retired;
+    atomic<uint64_t> *values = counters->values + OPERATIONS_COUNT * VALUES_PER_OPERATION;
+    count(values[0], 1, owned);
+    count(values[1], bytes, owned);
+}
+
+void BigIntegerStats::add_to(Snapshot &snapshot, const Counters &counters) {
+    for (int op = 0; op < OPERATIONS_COUNT; op++) {
+        const atomic<uint64_t> *values = counters.values + op * VALUES_PER_OPERATION;
+        OperationStats &stats = snapshot.operations[op];
+        stats.calls += values[0].load(std::memory_order_relaxed);
+        stats.bytes += values[1].load(std::memory_order_relaxed);
+        stats.nanoseconds += values[2].load(std::memory_order_relaxed);
+        for (int k = 0; k < HISTOGRAM_BUCKETS; k++)
+            stats.histogram[k] += values[3 + k].load(std::memory_order_relaxed);
+    }
+    const atomic<uint64_t> *values = counters.values + OPERATIONS_COUNT * VALUES_PER_OPERATION;
+    snapshot.allocations += values[0].load(std::memory_order_relaxed);
+    snapshot.allocated_bytes += values[1].load(std::memory_order_relaxed);
+}
+
+static BigIntegerStats::Snapshot subtract(BigIntegerStats::Snapshot a, const BigIntegerStats::Snapshot &b) {
+    for (int op = 0; op < BigIntegerStats::OPERATIONS_COUNT; op++) {
+        a.operations[op].calls -= b.operations[op].calls;
+        a.operations[op].bytes -= b.operations[op].bytes;
+        a.operations[op].nanoseconds -= b.operations[op].nanoseconds;
+        for (int k = 0; k < BigIntegerStats::HISTOGRAM_BUCKETS; k++)
+            a.operations[op].histogram[k] -= b.operations[op].histogram[k];
+    }
+    a.allocations -= b.allocations;
+    a.allocated_bytes -= b.allocated_bytes;
+    return a;
+}
+
+BigIntegerStats::Snapshot BigIntegerStats::snapshot() {
+    Registry &r = registry();
+    lock_guard<mutex> guard(r.lock);
+    Snapshot total{};
+    add_to(total, r.retired);
+    for (Counters *counters : r.live)
+        add_to(total, *counters);
+    return subtract(total, r.baseline);
+}
+
+void BigIntegerStats::reset() {
+    Registry &r = registry();
+    lock_guard<mutex> guard(r.lock);
+    Snapshot total{};
+    add_to(total, r.retired);
+    for (Counters *counters : r.live)
+        add_to(total, *counters);
+    r.baseline = total;
+}
+
+const char *BigIntegerStats::operation_name(const Operation operation) {
+    switch (operation) {
+        case PARSE: return "parse";
+        case TO_STRING: return "to_string";
+        case NEGATE: return "negate";
+        case ADD: return "add";
+        case SUB: return "sub";
+        case MUL: return "mul";
+        case DIV: return "div";
+        case DIVIDE_POSITIVE: return "divide_positive";
+        case SHIFT_LEFT: return "shift_left";
+        case SHIFT_RIGHT: return "shift_right";
+        case COMPARE: return "compare";
+        case BITWISE: return "bitwise";
+        case POWER: return "power";
+        case REALLOCATE: return "reallocate";
+        default: return "unknown";
+    }
+}
+
+string BigIntegerStats::Snapshot::to_text() const {
+
+    string text;
+    char line[256];
+
+    for (int op = 0; op < OPERATIONS_COUNT; op++) {
+        const OperationStats &stats = operations[op];
+        if (stats.calls == 0)
+            continue;
+        std::snprintf(line, sizeof(line), "%-16s calls %12llu  bytes %14llu  ns %16llu  avg ns %12.1f\n",
+                      operation_name(static_cast<Operation>(op)),
+                      static_cast<unsigned long long>(stats.calls),
+                      static_cast<unsigned long long>(stats.bytes),
+                      static_cast<unsigned long long>(stats.nanoseconds),
+                      static_cast<double>(stats.nanoseconds) / static_cast<double>(stats.calls));
+        text += line;
+
+        text += "                 sizes";
+        for (int k = 0; k < HISTOGRAM_BUCKETS; k++) {
+            if (stats.histogram[k] == 0)
+                continue;
+            std::snprintf(line, sizeof(line), "  <2^%d: %llu", k, static_cast<unsigned long long>(stats.histogram[k]));
+            text += line;
+        }
+        text += "\n";
+    }
+
+    std::snprintf(line, sizeof(line), "allocations %llu, bytes %llu\n",
+                  static_cast<unsigned long long>(allocations),
+                  static_cast<unsigned long long>(allocated_bytes));
+    text += line;
+    return text;
+}
+
+string BigIntegerStats::Snapshot::to_json() const {
+
+    string json = "{\"enabled\": ";
+    json += enabled() ? "true" : "false";
+    json += ", \"operations\": {";
+
+    char field[128];
+    bool first = true;
+    for (int op = 0; op < OPERATIONS_COUNT; op++) {
+        const OperationStats &stats = operations[op];
+        if (stats.calls == 0)
+            continue;
+        if (!first)
+            json += ", ";
+        first = false;
+
+        std::snprintf(field, sizeof(field), "\"%s\": {\"calls\": %llu, \"bytes\": %llu, \"nanoseconds\": %llu, ",
+                      operation_name(static_cast<Operation>(op)),
+                      static_cast<unsigned long long>(stats.calls),
+                      static_cast<unsigned long long>(stats.bytes),
+                      static_cast<unsigned long long>(stats.nanoseconds));
+        json += field;
+        json += "\"histogram\": [";
+        for (int k = 0; k < HISTOGRAM_BUCKETS; k++) {
+            std::snprintf(field, sizeof(field), k == 0 ? "%llu" : ", %llu",
+                          static_cast<unsigned long long>(stats.histogram[k]));
+            json += field;
+        }
+        json += "]}";
+    }
+
+    std::snprintf(field, sizeof(field), "}, \"allocations\": %llu, \"allocated_bytes\": %llu}",
+                  static_cast<unsigned long long>(allocations),
+                  static_cast<unsigned long long>(allocated_bytes));
+    json += field;
+    return json;
+}
@@ -0,0 +1,132 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+
+// Per-operation counters of BigInteger, compiled in only with BIGINTEGER_STATS defined.
+// Every thread counts into its own block, snapshot() sums all of them on demand.
+// Times are inclusive: a multiplication also counts the additions it performs.
+class BigIntegerStats {
+
+public:
+
+    enum Operation {
+        PARSE,
+        TO_STRING,
+        NEGATE,
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        DIVIDE_POSITIVE,
+        SHIFT_LEFT,
+        SHIFT_RIGHT,
+        COMPARE,
+        BITWISE,
+        POWER,
+        REALLOCATE,
+        OPERATIONS_COUNT
+    };
+
+    // bucket k counts calls whose operands had [2^(k-1), 2^k) bytes, bucket 0 - empty operands
+    static const int HISTOGRAM_BUCKETS = 32;
+
+    struct OperationStats {
+        uint64_t calls;
+        // operand bytes summed over the calls
+        uint64_t bytes;
+        uint64_t nanoseconds;
+        uint64_t histogram[HISTOGRAM_BUCKETS];
+    };
+
+    struct Snapshot {
+        OperationStats operations[OPERATIONS_COUNT];
+        uint64_t allocations;
+        uint64_t allocated_bytes;
+
+        string to_text() const;
+
+        string to_json() const;
+    };
+
+    static constexpr bool enabled() {
+#ifdef BIGINTEGER_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static const char *operation_name(Operation);
+
+    // sums counters of all threads, minus what was there at the last reset()
+    static Snapshot snapshot();
+
+    static void reset();
+
+    static void record(Operation, uint64_t bytes, uint64_t nanoseconds);
+
+    static void record_allocation(uint64_t bytes);
+
+    class Scope {
+
+    private:
+
+        const Operation _operation;
+        const uint64_t _bytes;
+        const std::chrono::steady_clock::time_point _start;
+
+    public:
+
+        Scope(Operation operation, uint64_t bytes) :
+                _operation(operation),
+                _bytes(bytes),
+                _start(std::chrono::steady_clock::now()) {}
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - _start;
+            record(_operation, _bytes,
+                   static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    };
+
+private:
+
+    static const int VALUES_PER_OPERATION = 3 + HISTOGRAM_BUCKETS;
+    static const int VALUES_COUNT = OPERATIONS_COUNT * VALUES_PER_OPERATION + 2;
+
+    struct Counters;
+
+    struct Registry;
+
+    static Registry &registry();
+
+    static Counters *thread_counters();
+
+    static void add_to(Snapshot &, const Counters &);
+};
+
+
+#ifdef BIGINTEGER_STATS
+#define BIGINTEGER_STATS_CONCAT_(a, b) a##b
+#define BIGINTEGER_STATS_CONCAT(a, b) BIGINTEGER_STATS_CONCAT_(a, b)
+#define BIGINTEGER_STATS_SCOPE(operation, bytes) \
+    BigIntegerStats::Scope BIGINTEGER_STATS_CONCAT(stats_scope_, __LINE__)(BigIntegerStats::operation, (bytes))
+#define BIGINTEGER_STATS_ALLOCATION(bytes) BigIntegerStats::record_allocation(bytes)
+#else
+#define BIGINTEGER_STATS_SCOPE(operation, bytes) ((void) 0)
+#define BIGINTEGER_STATS_ALLOCATION(bytes) ((void) 0)
+#endif
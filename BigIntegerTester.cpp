@@ -4,14 +4,35 @@
 //*******************************************//
 
 
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_map>
 #include "BigInteger.h"
+#include "BigAccumulator.h"
+#include "BigIntegerAsync.h"
+#include "BigIntegerChars.h"
+#include "BigIntegerConversion.h"
+#include "BigIntegerIngest.h"
+#include "BigIntegerKernels.h"
+#include "BigIntegerPowerCache.h"
+#include "BigIntegerRandom.h"
+#include "BigDecimal.h"
+#include "BigRational.h"
+#include "BigRNS.h"
+#include "BigIntegerStats.h"
+#include "BigIntegerThresholds.h"
 #include "BigIntegerTester.h"
 
 using std::cout;
 using std::endl;
 using std::to_string;
+using reference::Number;
+using reference::Access;
 
 void BigIntegerTester::test_all() {
 
@@ -26,6 +47,26 @@ void BigIntegerTester::test_all() {
     test_inc_dec();
     test_self_operator();
     test_power();
+    test_bitwise();
+    test_magnitude();
+    test_random();
+    test_word_operators();
+    test_accumulator();
+    test_kernels();
+    test_thresholds();
+    test_capacity();
+    test_copy_on_write();
+    test_hash();
+    test_parallel_conversion();
+    test_chars();
+    test_ingest();
+    test_power_cache();
+    test_gcd();
+    test_rational();
+    test_decimal();
+    test_rns();
+    test_async();
+    test_stats();
 }
 
 void BigIntegerTester::assert_expression
@@ -33,9 +74,9 @@ void BigIntegerTester::assert_expression
 
     cout << a << " ";
 
-    if (op == operator+) cout << "+";
-    if (op == operator*) cout << "*";
-    if (op == operator/) cout << "/";
+    if (op == static_cast<binary_operator>(operator+)) cout << "+";
+    if (op == static_cast<binary_operator>(operator*)) cout << "*";
+    if (op == static_cast<binary_operator>(operator/)) cout << "/";
     if (op == static_cast<binary_operator>(operator-)) cout << "-";
 
     cout << " " << b << " = " << ans << endl;
@@ -59,12 +100,12 @@ void BigIntegerTester::assert_expression
 
     cout << a << " ";
 
-    if (op == operator==) cout << "==";
-    if (op == operator!=) cout << "!=";
-    if (op == operator<=) cout << "<=";
-    if (op == operator>=) cout << ">=";
-    if (op == operator<) cout << "<";
-    if (op == operator>) cout << ">";
+    if (op == static_cast<cmp_operator>(operator==)) cout << "==";
+    if (op == static_cast<cmp_operator>(operator!=)) cout << "!=";
+    if (op == static_cast<cmp_operator>(operator<=)) cout << "<=";
+    if (op == static_cast<cmp_operator>(operator>=)) cout << ">=";
+    if (op == static_cast<cmp_operator>(operator<)) cout << "<";
+    if (op == static_cast<cmp_operator>(operator>)) cout << ">";
 
     cout << " " << b << endl;
     assert(op(BigInteger(a), BigInteger(b)));
@@ -146,6 +187,9 @@ void BigIntegerTester::test_negating() {
 
     assert_equal_expression(-(-BigInteger("-12345678901234567890")), "-12345678901234567890");
 
+    assert(-BigInteger("181") == BigInteger(-181));
+    assert(-BigInteger("-181") == BigInteger(181));
+
     cout << "\nSUCCESS!\n";
 }
 
@@ -159,6 +203,11 @@ void BigIntegerTester::test_shifts() {
     assert_expression("-1", operator<<, 8, "-256");
     assert_expression("256", operator>>, 8, "1");
     assert_expression("-128", operator<<, 9, "-65536");
+    assert_expression("-1", operator>>, 64, "-1");
+    assert_expression("-257", operator>>, 8, "-2");
+    assert_expression("-256", operator>>, 8, "-1");
+    assert_expression("65535", operator>>, 16, "0");
+    assert_expression("-65535", operator<<, 16, "-4294901760");
 
     assert_expression("88888888888888888889", operator>>, 2, "22222222222222222222");
     assert_expression("102410241024102410241025", operator>>, 8, "400040004000400040004");
@@ -183,6 +232,8 @@ void BigIntegerTester::test_shifts() {
     (a <<= 100) >>= 100;
     assert(a.to_string() == "12345678901234567890");
 
+    assert((BigInteger::ZERO << 200) == BigInteger::ZERO);
+
     cout << "\nSUCCESS!\n";
 }
 
@@ -225,6 +276,9 @@ void BigIntegerTester::test_add_sub() {
     (a -= BigInteger("12345678901234567890")) += BigInteger("12345678901234567890");
     assert(a.to_string() == "12345");
 
+    BigInteger b = BigInteger("-131072") + BigInteger("10196701442800096926");
+    assert((b - BigInteger("10196701442800096926")).to_string() == "-131072");
+
     cout << "\nSUCCESS!\n";
 }
 
@@ -251,6 +305,14 @@ void BigIntegerTester::test_mul_div() {
     assert_expression("101", operator/, "10", "10");
     assert_expression("-101", operator/, "10", "-11");
 
+    // several words in the divisor, with the estimated quotient word too large
+    assert_expression("115792089237316195423570985008687907853269984665640564039457584007913129639935", operator/,
+                      "340282366920938463463374607431768211455", "340282366920938463463374607431768211457");
+    assert_expression("6277101735386680763495507056286727952638980837032266301445", operator/,
+                      "340282366920938463454151235394913435648", "18446744073709551615");
+    assert_expression("57896044618658097708646941636650613544717097621216448811677614281724547563520", operator/,
+                      "3138550867693340381917894711603833208069624466305726808064", "18446744073709551614");
+
     try {
         BigInteger("12345") / BigInteger::ZERO;
         assert(false);
@@ -304,6 +366,9 @@ void BigIntegerTester::test_compare() {
     assert_expression("1234567890", operator!=, "-54321");
     assert_expression("1234567890", operator>, "-54321");
 
+    assert_expression("-1099511627775", operator>, "-17592186044415");
+    assert_expression("-17592186044415", operator<, "-1099511627775");
+
     cout << "\nSUCCESS!\n";
 }
 
@@ -363,6 +428,7 @@ void BigIntegerTester::test_power() {
     assert_power_expression("2", 1000, (BigInteger::ONE << 1000).to_string());
 
     assert_power_expression("1234567", 0, BigInteger::ONE.to_string());
+    assert_power_expression("2", 0, BigInteger::ONE.to_string());
     assert_power_expression("-123456789", 10, "82252625914710257950476114366153554776"
                                               "4137892295514168093701699676416207799736601");
     assert_power_expression("-123456789", 15, "-2358982165591483812094703636914720394"
@@ -398,3 +464,1187 @@ void BigIntegerTester::test_power() {
 
     cout << "\nSUCCESS!\n";
 }
+
+void BigIntegerTester::test_stats() {
+
+    cout << "\nTesting stats - ";
+
+    BigIntegerStats::reset();
+    BigInteger a("123456789012345678901234567890");
+    a *= BigInteger("987654321");
+    a.to_string();
+
+    BigIntegerStats::Snapshot stats = BigIntegerStats::snapshot();
+    if (BigIntegerStats::enabled()) {
+        assert(stats.operations[BigIntegerStats::PARSE].calls == 2);
+        assert(stats.operations[BigIntegerStats::MUL].calls >= 1);
+        assert(stats.operations[BigIntegerStats::ADD].calls > 0);
+        assert(stats.operations[BigIntegerStats::TO_STRING].calls == 1);
+        assert(stats.allocations > 0);
+        assert(stats.to_json().find("\"mul\": {\"calls\": ") != string::npos);
+
+        BigIntegerStats::reset();
+        stats = BigIntegerStats::snapshot();
+    }
+    assert(stats.operations[BigIntegerStats::MUL].calls == 0);
+    assert(stats.allocations == 0);
+
+    cout << "SUCCESS!\n";
+}
+
+// operand sizes around which fast paths switch algorithms, in bytes: byte and word boundaries,
+// then a limb either side of every threshold as currently tuned
+static vector<int> threshold_bytes() {
+    const int limb = static_cast<int>(sizeof(uint64_t));
+    vector<int> bytes = {1, 7, 8, 9, 15, 16, 17};
+    for (int i = 0; i < BigIntegerThresholds::COUNT; i++) {
+        const auto threshold = static_cast<BigIntegerThresholds::Threshold>(i);
+        // CONVERSION_LEAF alone is in bytes
+        const int at = static_cast<int>(BigIntegerThresholds::get(threshold)) *
+                       (threshold == BigIntegerThresholds::CONVERSION_LEAF ? 1 : limb);
+        bytes.insert(bytes.end(), {std::max(at - limb, 1), at, at + limb});
+    }
+    return bytes;
+}
+
+Number BigIntegerTester::random_reference_number(std::mt19937 &generator, const int max_bytes) {
+
+    Number a;
+    a.neg = false;
+    int length = static_cast<int>(generator() % max_bytes) + 1;
+    const vector<int> thresholds = threshold_bytes();
+
+    switch (generator() % 6) {
+        case 0:
+            for (int i = 0; i < length; i++)
+                a.bytes.push_back(static_cast<Byte>(generator()));
+            break;
+        case 1:
+            a.bytes.assign(static_cast<size_t>(length) + 1, BigInteger::MAX_BYTE);
+            a.bytes[0] = BigInteger::MIN_BYTE;
+            break;
+        case 2:
+            a = reference::shift_left(reference::from_long(1), generator() % (max_bytes * BigInteger::BITS_IN_BYTE));
+            break;
+        case 3:
+            a = reference::shift_left(reference::from_long(1), generator() % (max_bytes * BigInteger::BITS_IN_BYTE));
+            a = reference::subtract(a, reference::from_long(1));
+            break;
+        case 4:
+            a = reference::from_long(static_cast<long>(generator() % 5) - 2);
+            break;
+        default:
+            // beyond max_bytes too, so that every switch-over is crossed
+            length = thresholds[generator() % thresholds.size()];
+            for (int i = 0; i < length; i++)
+                a.bytes.push_back(static_cast<Byte>(generator()));
+            break;
+    }
+
+    a = reference::normalize(a);
+    return generator() % 2 ? reference::negate(a) : a;
+}
+
+bool BigIntegerTester::cross_check(const char *what, const BigInteger &a, const BigInteger &b, const bool ok) {
+    if (!ok)
+        cout << "\nMISMATCH in " << what
+             << "\n  a = " << reference::to_string(Access::read(a))
+             << "\n  b = " << reference::to_string(Access::read(b)) << endl;
+    return ok;
+}
+
+int BigIntegerTester::test_cross_check(const unsigned int seed, const int rounds, const int max_bytes) {
+
+    cout << "\nTesting against reference algorithms, seed " << seed << ", "
+         << rounds << " rounds up to " << max_bytes << " bytes - ";
+
+    std::mt19937 generator(seed);
+    int failures = 0;
+
+    for (int round = 0; round < rounds; round++) {
+
+        const Number ra = random_reference_number(generator, max_bytes);
+        const Number rb = random_reference_number(generator, max_bytes);
+        const BigInteger a = Access::write(ra);
+        const BigInteger b = Access::write(rb);
+        const unsigned int shift = generator() % (max_bytes * BigInteger::BITS_IN_BYTE + 9);
+        const unsigned int exponent = generator() % 6;
+
+        auto same = [](const BigInteger &x, const Number &expected) {
+            return Access::normalized(x) && reference::equal(Access::read(x), expected);
+        };
+
+        failures += !cross_check("to_string", a, b, a.to_string() == reference::to_string(ra));
+        failures += !cross_check("parse", a, b, same(BigInteger(reference::to_string(ra)), ra));
+        failures += !cross_check("negate", a, b, same(-a, reference::negate(ra)));
+        failures += !cross_check("a + b", a, b, same(a + b, reference::add(ra, rb)));
+        failures += !cross_check("a - b", a, b, same(a - b, reference::subtract(ra, rb)));
+        failures += !cross_check("a * b", a, b, same(a * b, reference::multiply(ra, rb)));
+        failures += !cross_check("a << s", a, b, same(a << shift, reference::shift_left(ra, shift)));
+        failures += !cross_check("a >> s", a, b, same(a >> shift, reference::shift_right(ra, shift)));
+        failures += !cross_check("power", a, b, same(power(a, exponent), reference::power(ra, exponent)));
+
+        failures += !cross_check("a & b", a, b, same(a & b, reference::bitwise_and(ra, rb)));
+        failures += !cross_check("a | b", a, b, same(a | b, reference::bitwise_or(ra, rb)));
+        failures += !cross_check("a ^ b", a, b, same(a ^ b, reference::bitwise_xor(ra, rb)));
+        failures += !cross_check("~a", a, b, same(~a, reference::bitwise_not(ra)));
+        failures += !cross_check("test_bit", a, b, a.test_bit(shift) == reference::get_bit(ra, shift));
+        failures += !cross_check("popcount", a, b, a.popcount() == reference::popcount(ra));
+        failures += !cross_check("bit_length", a, b, a.bit_length() == reference::bit_length(ra));
+
+        BigInteger flipped(a);
+        flipped.set_bit(shift, !a.test_bit(shift));
+        failures += !cross_check("set_bit", a, b, same(flipped, reference::bitwise_xor(
+                ra, reference::shift_left(reference::from_long(1), shift))));
+
+        int cmp = BigInteger::compare(a, b);
+        int expected_cmp = reference::compare(ra, rb);
+        failures += !cross_check("compare", a, b, (cmp > 0) == (expected_cmp > 0) && (cmp < 0) == (expected_cmp < 0));
+        failures += !cross_check("a == b", a, b, (a == b) == (expected_cmp == 0));
+        failures += !cross_check("a < b", a, b, (a < b) == (expected_cmp < 0));
+
+        BigInteger c(a);
+        failures += !cross_check("++a", a, b, same(++c, reference::add(ra, reference::from_long(1))));
+        failures += !cross_check("--a", a, b, same(--(--c), reference::subtract(ra, reference::from_long(1))));
+
+        failures += !cross_check("(a + b) - b", a, b, same((a + b) - b, ra));
+        failures += !cross_check("(a << s) >> s", a, b, same((a << shift) >> shift, ra));
+
+        // words of random length, signed and unsigned
+        const uint64_t bits = generator() | static_cast<uint64_t>(generator()) << 32;
+        const unsigned long uw = bits >> (generator() % 64);
+        const long sw = static_cast<long>(bits) >> (generator() % 64);
+        const Number ruw = reference::from_unsigned(uw), rsw = reference::from_long(sw);
+        failures += !cross_check("a + word", a, b, same(a + uw, reference::add(ra, ruw)) && same(a + sw, reference::add(ra, rsw)));
+        failures += !cross_check("a - word", a, b, same(a - uw, reference::subtract(ra, ruw)) && same(a - sw, reference::subtract(ra, rsw)));
+        failures += !cross_check("a * word", a, b, same(a * uw, reference::multiply(ra, ruw)) && same(a * sw, reference::multiply(ra, rsw)));
+        if (uw != 0) {
+            Number q = reference::divide(ra, ruw);
+            failures += !cross_check("a / word", a, b, same(a / uw, q));
+            Number r = reference::subtract(ra, reference::multiply(q, ruw));
+            failures += !cross_check("remainder", a, b, same(BigInteger(0) + a.remainder(uw), r));
+        }
+        if (sw != 0)
+            failures += !cross_check("a / signed word", a, b, same(a / sw, reference::divide(ra, rsw)));
+
+        BigAccumulator accumulator;
+        accumulator.add(a).subtract(b).add_product(a, b).add_product(b, -a);
+        failures += !cross_check("accumulator", a, b, same(accumulator.result(), reference::subtract(ra, rb)));
+
+        if (BigInteger::compare(b, BigInteger::ZERO) != 0) {
+            BigInteger q = a / b;
+            failures += !cross_check("a / b", a, b, same(q, reference::divide(ra, rb)));
+            failures += !cross_check("(a * b) / b", a, b, same((a * b) / b, ra));
+
+            // the remainder of a / b lies in [0, |b|)
+            Number r = reference::subtract(ra, reference::multiply(Access::read(q), rb));
+            Number rb_abs = rb.neg ? reference::negate(rb) : rb;
+            failures += !cross_check("divmod", a, b, !r.neg && reference::compare(r, rb_abs) < 0);
+        }
+    }
+
+    cout << (failures == 0 ? "SUCCESS!\n" : "FAILED!\n");
+    return failures;
+}
+
+void BigIntegerTester::test_magnitude() {
+
+    cout << "\nTesting magnitude queries - ";
+
+    const BigInteger two_53 = power(BigInteger(2), 53);
+    assert(BigInteger(0).to_double() == 0 && BigInteger(-1).to_double() == -1);
+    assert((two_53 + 1).to_double() == 9007199254740992.0 && (two_53 + 3).to_double() == 9007199254740996.0);
+    assert((-two_53 - 3).to_double() == -9007199254740996.0 && (two_53 * 2 + 2).to_double() == 18014398509481984.0);
+    assert(std::isinf(power(BigInteger(2), 1024).to_double()) && (-power(BigInteger(2), 5000)).to_double() < 0);
+    assert((power(BigInteger(2), 1024) - power(BigInteger(2), 970) - 1).to_double() == 1.7976931348623157e308);
+    assert(std::isinf((power(BigInteger(2), 1024) - power(BigInteger(2), 970)).to_double()));
+
+    // the C library reads decimal strings correctly rounded, and so gives the expected results
+    BigInteger value(7);
+    for (int i = 0; i < 300; i++) {
+        value *= i % 3 == 0 ? -1000003 : 999983;
+        value += i % 4 == 0 ? BigInteger(0) : BigInteger(i) << (i * 3);
+        const string decimal = value.to_string();
+        assert(value.to_double() == std::strtod(decimal.c_str(), nullptr));
+
+        const size_t digits = decimal.size() - (value.is_neg() ? 1 : 0);
+        const size_t estimate = value.digits10_estimate();
+        assert(estimate + 1 >= digits && estimate <= digits + 1);
+        assert(std::fabs(value.log10() - std::log10(std::fabs(std::strtod(decimal.c_str(), nullptr)))) < 1e-9 ||
+               std::isinf(value.to_double()));
+    }
+
+    for (unsigned int k : {1u, 63u, 64u, 65u, 1000u, 100000u}) {
+        const BigInteger power_of_two = power(BigInteger(2), k);
+        assert(power_of_two.bit_length() == k + 1 && (-power_of_two).bit_length() == k);
+        assert(std::fabs(power_of_two.log2() - k) < 1e-9 && std::fabs((-power_of_two).log2() - k) < 1e-9);
+        const BigInteger power_of_ten = power(BigInteger(10), k);
+        assert(std::fabs(power_of_ten.log10() - k) < 1e-9);
+        assert(power_of_ten.digits10_estimate() + 1 >= k + 1 && (power_of_ten - 1).digits10_estimate() <= k + 1);
+    }
+    assert(std::isinf(BigInteger(0).log2()) && BigInteger(0).digits10_estimate() == 1);
+
+    const double doubles[] = {0.0, -0.75, 2.5, -2.5, 1e20, -9007199254740993.0, 1.7976931348623157e308, 4503599627370495.5};
+    for (double d : doubles)
+        assert(BigInteger::from_double(d).to_double() == std::trunc(d));
+    assert(BigInteger::from_double(1e20) == power(BigInteger(10), 20) && BigInteger::from_double(-2.5) == -2);
+    assert(BigInteger::from_double(std::ldexp(1.0, 1000)) == power(BigInteger(2), 1000));
+    try {
+        BigInteger::from_double(std::nan(""));
+        assert(false);
+    } catch (BigInteger::BigIntegerException &e) {
+        assert(e.get_error_message() == "Not a finite number");
+    }
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_random() {
+
+    cout << "\nTesting random values - ";
+
+    using Random = BigIntegerRandom;
+
+    std::mt19937_64 generator(47), same(47);
+    assert(Random::random_bits(0, generator) == 0);
+    assert(Random::random_bits(1000, generator) == Random::random_bits(1000, same));
+
+    // every bit is set about half of the time
+    const BigInteger two_130 = power(BigInteger(2), 130);
+    int top_set = 0, low_set = 0;
+    for (int i = 0; i < 2000; i++) {
+        const BigInteger value = Random::random_bits(131, generator);
+        assert(value >= 0 && value < two_130 * 2);
+        top_set += value.test_bit(130) ? 1 : 0;
+        low_set += value.test_bit(0) ? 1 : 0;
+    }
+    assert(top_set > 850 && top_set < 1150 && low_set > 850 && low_set < 1150);
+
+    // all remainders of a small bound turn up about equally often
+    int counts[6] = {};
+    for (int i = 0; i < 6000; i++) {
+        const BigInteger value = Random::random_below(BigInteger(6), generator);
+        assert(value >= 0 && value < 6);
+        counts[value.remainder(6)]++;
+    }
+    for (int count : counts)
+        assert(count > 850 && count < 1150);
+
+    // a bound just above a power of two rejects almost every top word but one
+    const BigInteger bound = two_130 + 1;
+    std::minstd_rand narrow(5);
+    vector<BigInteger> values(300, BigInteger(-7));
+    Random::fill_below(values, bound, narrow);
+    for (const BigInteger &value : values)
+        assert(value >= 0 && value < bound);
+    assert(values[0] != values[1] && values[1] != values[2]);
+
+    // a batch keeps the buffers of the values it overwrites
+    Random::fill_bits(values, 4000, generator);
+    const int capacity = values[0].capacity();
+    Random::fill_bits(values, 4000, generator);
+    assert(values[0].capacity() == capacity && values[0].bit_length() > 3900 && values[0] != values[1]);
+
+    for (const BigInteger &invalid : {BigInteger(0), BigInteger(-5)}) {
+        try {
+            Random::random_below(invalid, generator);
+            assert(false);
+        } catch (BigInteger::BigIntegerException &e) {
+            assert(e.get_error_message() == "Bound is not positive");
+        }
+    }
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_bitwise() {
+
+    cout << "\nTesting bitwise operators - ";
+
+    assert((BigInteger(12) & BigInteger(10)) == BigInteger(8));
+    assert((BigInteger(12) | BigInteger(10)) == BigInteger(14));
+    assert((BigInteger(12) ^ BigInteger(10)) == BigInteger(6));
+    assert(~BigInteger(12) == BigInteger(-13));
+    assert(~BigInteger(-1) == BigInteger::ZERO);
+
+    assert((BigInteger(-12) & BigInteger(10)) == BigInteger(0));
+    assert((BigInteger(-12) | BigInteger(10)) == BigInteger(-2));
+    assert((BigInteger(-12) ^ BigInteger(-10)) == BigInteger(2));
+
+    BigInteger big("340282366920938463463374607431768211455");
+    assert((big & BigInteger(-256)) == big - BigInteger(255));
+    assert((big ^ big) == BigInteger::ZERO);
+    assert((big | -big) == BigInteger(-1));
+    assert(((big >> 64) & BigInteger(-1)) == BigInteger("18446744073709551615"));
+
+    assert(big.popcount() == 128);
+    assert(big.bit_length() == 128);
+    assert(big.trailing_zeros() == 0);
+    assert((big + BigInteger::ONE).trailing_zeros() == 128);
+    assert(BigInteger::ZERO.trailing_zeros() == -1);
+    assert(BigInteger(-1).bit_length() == 0);
+    assert(BigInteger(-129).bit_length() == 8);
+    assert(BigInteger(-8).popcount() == 3);
+
+    BigInteger a(0);
+    a.set_bit(100);
+    assert(a == BigInteger::ONE << 100);
+    assert(a.test_bit(100) && !a.test_bit(99) && !a.test_bit(101));
+    a.set_bit(100, false);
+    assert(a == BigInteger::ZERO);
+
+    BigInteger b(-1);
+    b.set_bit(70, false);
+    assert(b == -(BigInteger::ONE << 70) - BigInteger::ONE);
+    assert(b.test_bit(1000) && !b.test_bit(70));
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_word_operators() {
+
+    cout << "\nTesting operators with machine words - ";
+
+    BigInteger a("123456789012345678901234567890");
+    assert(a + 10 == BigInteger("123456789012345678901234567900"));
+    assert(a - 90 == BigInteger("123456789012345678901234567800"));
+    assert(a * 1000 == BigInteger("123456789012345678901234567890000"));
+    assert(a / 10 == BigInteger("12345678901234567890123456789"));
+    assert(a * -3 == BigInteger("-370370367037037036703703703670"));
+    assert((-a - 3) / 7 == BigInteger("-17636684144620811271604938271"));
+    assert(a / -7 == BigInteger("-17636684144620811271604938270"));
+    assert(a.remainder(7) == 0);
+    assert((a + 3).remainder(7) == 3);
+    assert((-a - 3).remainder(7) == 4);
+    assert(5 + a == a + BigInteger(5));
+    assert(3 * a == a * BigInteger(3));
+
+    const uint64_t max_word = UINT64_MAX;
+    BigInteger b = BigInteger(0) + max_word;
+    assert(b.to_string() == "18446744073709551615");
+    assert((b + max_word).to_string() == "36893488147419103230");
+    assert((b * max_word).to_string() == "340282366920938463426481119284349108225");
+    assert(((b * max_word) / max_word) == b);
+    assert((BigInteger(0) - max_word).to_string() == "-18446744073709551615");
+    assert((BigInteger(-1) * max_word).to_string() == "-18446744073709551615");
+    assert((BigInteger(1) - INT64_MIN).to_string() == "9223372036854775809");
+    assert((BigInteger(0) * INT64_MIN).to_string() == "0");
+
+    BigInteger c(-256);
+    c += 256;
+    assert(c == BigInteger::ZERO && !c.is_neg());
+    c -= 1;
+    assert(c == BigInteger(-1));
+
+    try {
+        a /= 0;
+        assert(false);
+    } catch (const BigInteger::BigIntegerException &) {}
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_accumulator() {
+
+    cout << "\nTesting accumulator - ";
+
+    BigAccumulator sum;
+    BigInteger expected(0);
+    BigInteger value("-98765432109876543210987654321");
+    for (int i = 0; i < 1000; i++) {
+        sum.add(value);
+        expected += value;
+        value *= -3;
+        value += i;
+    }
+    assert(sum.result() == expected);
+
+    sum.subtract(expected);
+    assert(sum.result() == BigInteger::ZERO);
+
+    BigInteger a("123456789012345678901234567890"), b("-987654321098765432109876543210");
+    sum.add_product(a, b);
+    sum.add_product(b, b);
+    assert(sum.result() == a * b + b * b);
+
+    BigAccumulator other;
+    other.add(BigInteger(-1));
+    for (int i = 0; i < 3; i++)
+        sum.merge(other);
+    assert(sum.result() == a * b + b * b - BigInteger(3));
+
+    sum.merge(sum);
+    assert(sum.result() == (a * b + b * b - BigInteger(3)) * 2);
+
+    sum.clear();
+    sum.subtract(BigInteger::ONE << 64);
+    assert(sum.result() == -(BigInteger::ONE << 64));
+    assert(BigAccumulator().result() == BigInteger::ZERO);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_kernels() {
+
+    cout << "\nTesting kernels - ";
+
+    using mpn::limb;
+
+    std::mt19937_64 generator(38);
+    auto random_limbs = [&generator](vector<limb> &limbs) {
+        for (limb &x : limbs)
+            x = generator() % 4 == 0 ? ~static_cast<limb>(0) : generator();
+    };
+
+    // carries and borrows, over the limbs of all ones as well
+    vector<limb> a(9), b(9), r(9);
+    random_limbs(a);
+    random_limbs(b);
+    const limb carry = mpn::add_n(r.data(), a.data(), b.data(), 9);
+    assert(mpn::sub_n(r.data(), r.data(), b.data(), 9) == carry);
+    assert(r == a);
+    vector<limb> ones(4, ~static_cast<limb>(0)), zeros(4, 0);
+    assert(mpn::add_1(r.data(), ones.data(), 4, 1) == 1 && mpn::cmp(r.data(), zeros.data(), 4) == 0);
+    assert(mpn::sub_1(r.data(), zeros.data(), 4, 1) == 1 && mpn::cmp(r.data(), ones.data(), 4) == 0);
+    assert(mpn::normalized_size(zeros.data(), 4) == 0 && mpn::normalized_size(ones.data(), 4) == 4);
+
+    assert(mpn::lshift(r.data(), a.data(), 9, 13) == a[8] >> 51);
+    assert(mpn::rshift(r.data(), r.data(), 9, 13) == 0);
+    a[8] &= ~static_cast<limb>(0) >> 13;
+    assert(r == a);
+
+    // every product against the schoolbook one, around the Karatsuba thresholds and unbalanced
+    const size_t sizes[][2] = {{1, 1}, {7, 3}, {31, 31}, {32, 32}, {47, 33}, {64, 32}, {65, 40}, {100, 100},
+                               {150, 37}, {200, 199}, {333, 129}};
+    for (const auto &size : sizes) {
+        const size_t n = size[0], m = size[1];
+        vector<limb> x(n), y(m), expected(n + m), product(n + m), scratch(mpn::mul_scratch_size(n));
+        random_limbs(x);
+        random_limbs(y);
+        mpn::mul_basecase(expected.data(), x.data(), n, y.data(), m);
+        mpn::mul(product.data(), x.data(), n, y.data(), m, scratch.data());
+        assert(product == expected);
+
+        vector<limb> square(2 * n);
+        expected.resize(2 * n);
+        mpn::mul_basecase(expected.data(), x.data(), n, x.data(), n);
+        mpn::sqr(square.data(), x.data(), n, scratch.data());
+        assert(square == expected);
+        mpn::sqr_basecase(square.data(), x.data(), n);
+        assert(square == expected);
+
+        // (x y + z) / y with z < y gives back x and z
+        if (m > 1) {
+            y[m - 1] |= static_cast<limb>(1) << 63;
+            vector<limb> z(m), u(n + m), q(n);
+            random_limbs(z);
+            z[m - 1] = y[m - 1] - 1;
+            mpn::mul(u.data(), x.data(), n, y.data(), m, scratch.data());
+            mpn::add(u.data(), u.data(), n + m, z.data(), m);
+            const limb top = mpn::divrem(q.data(), u.data(), n + m, y.data(), m);
+            assert(top == 0 && q == x);
+            assert(mpn::cmp(u.data(), z.data(), m) == 0);
+        }
+
+        const limb d = y[0] | 1;
+        vector<limb> u(n + 1), q(n + 1);
+        u[n] = mpn::mul_1(u.data(), x.data(), n, d);
+        assert(mpn::divrem_1(q.data(), u.data(), n + 1, d) == 0 && q[n] == 0);
+        assert(std::equal(x.begin(), x.end(), q.begin()));
+        assert(mpn::submul_1(u.data(), x.data(), n, d) == u[n]);
+    }
+
+    // every variant the processor has agrees with the generic one
+    {
+        const string chosen = mpn::kernels();
+        assert(mpn::use_kernels("generic") && !mpn::use_kernels("unknown"));
+        vector<limb> u(70), v(45), product(115), square(140), row(70);
+        random_limbs(u);
+        random_limbs(v);
+        vector<limb> expected_product(115), expected_square(140);
+        mpn::mul_basecase(expected_product.data(), u.data(), 70, v.data(), 45);
+        mpn::sqr_basecase(expected_square.data(), u.data(), 70);
+        const limb expected_high = mpn::addmul_1(row.data(), u.data(), 70, v[0]);
+        const vector<limb> expected_row = row;
+        for (const char *name : {"bmi2", "generic"}) {
+            if (!mpn::use_kernels(name))
+                continue;
+            assert(string(mpn::kernels()) == name);
+            mpn::mul_basecase(product.data(), u.data(), 70, v.data(), 45);
+            mpn::sqr_basecase(square.data(), u.data(), 70);
+            std::fill(row.begin(), row.end(), 0);
+            assert(mpn::addmul_1(row.data(), u.data(), 70, v[0]) == expected_high && row == expected_row);
+            assert(product == expected_product && square == expected_square);
+        }
+        assert(mpn::use_kernels(chosen.c_str()));
+    }
+
+    // and through BigInteger, with operands past the thresholds
+    BigInteger x = power(BigInteger("-12345678901234567891"), 200) + 17;
+    BigInteger y = power(BigInteger("98765432109876543211"), 130) - 5;
+    BigInteger product = x * y;
+    assert(product / y == x && product / x == y);
+    assert((product + 3) / y == x);
+    assert(product - x * (y - 1) == x);
+    BigInteger square(x);
+    square *= square;
+    assert(square == x * BigInteger(x) && square / x == x);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_thresholds() {
+
+    cout << "\nTesting thresholds - ";
+
+    using Thresholds = BigIntegerThresholds;
+
+    const BigInteger a = power(BigInteger("-12345678901234567891"), 150) + 1;
+    const BigInteger b = power(BigInteger("98765432109876543211"), 90) - 1;
+    const BigInteger product = a * b, square = a * BigInteger(a), sum = a + b;
+    const string decimal = a.to_string();
+
+    const char *path = "BigIntegerThresholds.test.cfg";
+    {
+        std::ofstream file(path);
+        file << "# smallest\nmul_karatsuba = 2\nsqr_karatsuba=0   # raised to 2\n\nadd_limbs = 1\nconversion_leaf = 8\n";
+    }
+    assert(Thresholds::load(path));
+    assert(Thresholds::get(Thresholds::MUL_KARATSUBA) == 2 && Thresholds::get(Thresholds::SQR_KARATSUBA) == 2);
+    assert(Thresholds::config().find("conversion_leaf = 8\n") != string::npos);
+    assert(Thresholds::header().find("#define BIGINTEGER_THRESHOLD_ADD_LIMBS 1\n") != string::npos);
+
+    // Karatsuba all the way down gives the same results
+    BigInteger x(a);
+    x *= x;
+    assert(a * b == product && x == square && a + b == sum);
+    assert(BigIntegerConversion::to_string(a) == decimal && BigIntegerConversion::parse(decimal) == a);
+
+    // an invalid file changes nothing
+    {
+        std::ofstream file(path);
+        file << "mul_karatsuba = 100\nunknown = 3\n";
+    }
+    assert(!Thresholds::load(path));
+    assert(!Thresholds::load("no/such/file.cfg"));
+    assert(Thresholds::get(Thresholds::MUL_KARATSUBA) == 2);
+    std::remove(path);
+
+    Thresholds::set(Thresholds::MUL_KARATSUBA, 1000);
+    assert(a * b == product);
+    Thresholds::reset();
+    assert(Thresholds::get(Thresholds::MUL_KARATSUBA) != 2 && string(Thresholds::name(Thresholds::ADD_LIMBS)) == "add_limbs");
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_capacity() {
+
+    cout << "\nTesting capacity - ";
+
+    const BigInteger big = power(BigInteger(3), 3000);
+
+    // copies that do not share take only what the value needs
+    BigInteger::set_copy_on_write(false);
+    BigInteger x(big);
+    assert(x.capacity() == x.size() && x == big);
+    const BigInteger five(5);
+    x = five;
+    assert(x.capacity() == x.size() && x == 5);
+    BigInteger::set_copy_on_write(true);
+
+    // a value that shrank gives its buffer back
+    x = big;
+    x >>= 4000;
+    assert(x == (big >> 4000) && x.capacity() <= x.size() * 4 + BigInteger::TRIM_SLACK);
+
+    // the reservation survives shrinking until shrink_to_fit()
+    BigInteger y(7);
+    y.reserve(4096);
+    assert(y.capacity() >= 4096 / 8 + 1 && y == 7);
+    y += big;
+    y -= big;
+    y *= 3;
+    assert(y == 21 && y.capacity() >= 4096 / 8 + 1);
+    y = five;
+    assert(y == 5 && y.capacity() >= 4096 / 8 + 1);
+    y.shrink_to_fit();
+    assert(y == 5 && y.capacity() == y.size());
+
+    // trimming can be turned off for the whole process
+    BigInteger::set_growth_policy({200, 0});
+    assert(BigInteger::growth_policy().growth_percent == 200 && BigInteger::growth_policy().trim_percent == 0);
+    BigInteger z(big);
+    z >>= 4000;
+    assert(z == (big >> 4000) && z.capacity() == big.size());
+    BigInteger::set_growth_policy(BigInteger::DEFAULT_GROWTH_POLICY);
+    assert(BigInteger::growth_policy().trim_percent == BigInteger::DEFAULT_GROWTH_POLICY.trim_percent);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_copy_on_write() {
+
+    cout << "\nTesting copy on write - ";
+
+    const BigInteger big = power(BigInteger(-7), 500);
+    const string decimal = big.to_string();
+
+    // copies share the buffer until one of them changes
+    BigInteger x(big), y = big;
+    BigInteger z;
+    z = x;
+    assert(x.is_shared() && big.is_shared() && x == big && y == big && z == big);
+    x += 1;
+    assert(x == big + 1 && x.capacity() == x.size() && y.is_shared());
+    y.negate();
+    z *= z;
+    assert(!big.is_shared() && !y.is_shared() && y == -big && z == big * big && big.to_string() == decimal);
+
+    // every kind of change detaches first
+    const BigInteger small(1234567);
+    BigInteger copies[14];
+    for (BigInteger &copy : copies)
+        copy = big;
+    copies[0] <<= 3, copies[1] >>= 3, copies[2] >>= 100000, copies[3] -= big;
+    copies[4] /= small, copies[5] &= small, copies[6] |= small, copies[7] ^= small;
+    copies[8].invert(), copies[9].set_bit(4000), copies[10].set_bit(0, false), copies[11] *= 0;
+    copies[12] /= 3, copies[13] += big;
+    assert(copies[0] == big * 8 && copies[1] == big / 8 && copies[2] == 0 && copies[3] == 0);
+    assert(copies[4] == big / small && copies[5] == (big & small));
+    assert(copies[11] == 0 && copies[12] == big / 3 && copies[13] == big * 2 && copies[8] == -big - 1);
+    assert(big.to_string() == decimal && !big.is_shared());
+
+    // a reserved buffer is kept, so assigning to it copies
+    BigInteger reserved;
+    reserved.reserve(8000);
+    reserved = big;
+    assert(!reserved.is_shared() && reserved.capacity() >= 8000 / 8 + 1 && reserved == big);
+
+    // values shared between threads are copied and changed concurrently
+    BigIntegerThreadPool pool(3);
+    std::vector<std::future<BigInteger>> tasks;
+    for (int i = 0; i < 12; i++)
+        tasks.push_back(pool.submit([&big, i]() {
+            BigInteger sum;
+            for (int k = 0; k < 200; k++) {
+                BigInteger copy(big);
+                copy += i;
+                sum += copy;
+            }
+            return sum;
+        }));
+    for (int i = 0; i < 12; i++)
+        assert(pool.wait(tasks[i]) == (big + i) * 200);
+    assert(big.to_string() == decimal && !big.is_shared());
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_hash() {
+
+    cout << "\nTesting hash - ";
+
+    const std::hash<BigInteger> hash;
+
+    // equal values hash alike, whatever their buffers
+    const BigInteger big = power(BigInteger(-3), 400);
+    BigInteger roomy = -(-big);
+    roomy.reserve(20000);
+    assert(roomy == big && hash(roomy) == hash(big) && hash(BigInteger(big)) == hash(big));
+    assert(hash(BigInteger("-0")) == hash(BigInteger::ZERO));
+    BigInteger counted = big;
+    counted += 1;
+    counted -= 1;
+    assert(counted == big && hash(counted) == hash(big));
+
+    // values of a byte or a word apart, of opposite sign and of every length
+    vector<BigInteger> values;
+    for (int bits = 0; bits <= 300; bits++) {
+        const BigInteger value = power(BigInteger(2), static_cast<unsigned int>(bits));
+        values.push_back(value);
+        values.push_back(-value);
+        values.push_back(value + 255);
+        values.push_back(value - 1);
+    }
+    std::unordered_map<BigInteger, int> indices;
+    for (size_t i = 0; i < values.size(); i++)
+        indices.emplace(values[i], static_cast<int>(i));
+    for (const BigInteger &value : values)
+        assert(values[indices.at(value)] == value);
+
+    std::unordered_map<size_t, int> seen;
+    for (const auto &entry : indices)
+        seen[hash(entry.first)]++;
+    assert(seen.size() == indices.size());
+
+    // equal needs sign, size and bytes alike
+    assert(BigInteger(255) != BigInteger(-1) && BigInteger(-256) != BigInteger(256));
+    assert(BigInteger::equal(big, roomy) && !BigInteger::equal(big, big + 1) && !BigInteger::equal(big, -big));
+    assert(BigInteger::compare(big, big + 1) < 0 && BigInteger::compare(-big, -big - 1) > 0);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_parallel_conversion() {
+
+    cout << "\nTesting parallel conversion - ";
+
+    BigIntegerThreadPool inline_pool(0), pool_of_three(3);
+    BigIntegerThreadPool *pools[] = {&inline_pool, &pool_of_three};
+    const BigInteger values[] = {
+            BigInteger::ZERO,
+            BigInteger(-5),
+            power(BigInteger("123456789123456789"), 400),
+            -power(BigInteger("987654321987654321987"), 700) - BigInteger(1),
+            power(BigInteger(10), 19 * 64),
+            power(BigInteger(10), 19 * 64) - BigInteger(1),
+            power(BigInteger(10), 19 * 300 + 1)
+    };
+
+    for (BigIntegerThreadPool *pool_it : pools) {
+        BigIntegerThreadPool &pool = *pool_it;
+        for (const BigInteger &value : values) {
+            const string digits = value.to_string();
+            assert(BigIntegerConversion::to_string(value, pool) == digits);
+            assert(BigIntegerConversion::parse(digits, pool) == value);
+        }
+
+        const string padded = string(5000, '0') + "123";
+        assert(BigIntegerConversion::parse(padded, pool) == BigInteger(123));
+        assert(BigIntegerConversion::parse("-" + padded, pool) == BigInteger(-123));
+
+        bool thrown = false;
+        try {
+            BigIntegerConversion::parse(string(5000, '7') + "x", pool);
+        } catch (BigInteger::BigIntegerException &) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_chars() {
+
+    cout << "\nTesting to_chars, from_chars - ";
+
+    using Chars = BigIntegerChars;
+
+    const BigInteger values[] = {
+            BigInteger(0), BigInteger(-1), BigInteger(255), BigInteger(-256), BigInteger("9999999999999999999"),
+            BigInteger("10000000000000000000"), BigInteger("-18446744073709551616"), power(BigInteger(2), 64) - 1,
+            power(BigInteger(-3), 401), power(BigInteger(10), 95), -power(BigInteger(2), 1000), power(BigInteger(7), 777)
+    };
+    char buffer[1000];
+
+    for (const BigInteger &value : values) {
+        const string decimal = value.to_string();
+        const size_t needed = Chars::digits_needed(value);
+        assert(needed == decimal.size() || needed == decimal.size() + 1);
+
+        // exactly as long as the digits, and one shorter
+        Chars::ToCharsResult written = Chars::to_chars(buffer, buffer + decimal.size(), value);
+        assert(written.ec == std::errc() && string(buffer, written.ptr) == decimal);
+        written = Chars::to_chars(buffer, buffer + decimal.size() - 1, value);
+        assert(written.ec == std::errc::value_too_large && written.ptr == buffer + decimal.size() - 1);
+
+        BigInteger parsed(12345);
+        Chars::FromCharsResult read = Chars::from_chars(decimal.data(), decimal.data() + decimal.size(), parsed);
+        assert(read.ec == std::errc() && read.ptr == decimal.data() + decimal.size() && parsed == value);
+
+        const size_t hex_digits = Chars::digits_needed(value, 16);
+        written = Chars::to_chars(buffer, buffer + hex_digits, value, 16);
+        assert(written.ec == std::errc() && written.ptr == buffer + hex_digits);
+        assert(Chars::to_chars(buffer, buffer + hex_digits - 1, value, 16).ec == std::errc::value_too_large);
+        read = Chars::from_chars(buffer, written.ptr, parsed, 16);
+        assert(read.ec == std::errc() && read.ptr == written.ptr && parsed == value);
+    }
+
+    BigInteger value;
+    char text[] = "-ff80000000000000000000AbZ";
+    Chars::ToCharsResult written = Chars::to_chars(buffer, buffer + sizeof(buffer), -power(BigInteger(2), 75), 16);
+    assert(string(buffer, written.ptr) == "-8" + string(18, '0'));
+    Chars::FromCharsResult read = Chars::from_chars(text, text + sizeof(text) - 1, value, 16);
+    assert(read.ec == std::errc() && *read.ptr == 'Z' && value == -((BigInteger(0xff8) << 84) + 0xab));
+    read = Chars::from_chars(text, text + sizeof(text) - 1, value);
+    assert(read.ec == std::errc::invalid_argument && read.ptr == text && value == -((BigInteger(0xff8) << 84) + 0xab));
+
+    const string digits = "0000000000000000000000000000000000000000042 and more";
+    read = Chars::from_chars(digits.data(), digits.data() + digits.size(), value);
+    assert(read.ec == std::errc() && *read.ptr == ' ' && value == 42);
+    assert(Chars::from_chars(text, text + 1, value).ec == std::errc::invalid_argument && value == 42);
+    assert(Chars::from_chars(text, text, value).ec == std::errc::invalid_argument);
+    assert(Chars::to_chars(buffer, buffer, BigInteger(-5)).ec == std::errc::value_too_large);
+    assert(Chars::to_chars(buffer, buffer + 10, value, 8).ec == std::errc::invalid_argument);
+    assert(Chars::digits_needed(value, 8) == 0);
+
+    // a buffer that fits is reused
+    value.reserve(4000);
+    const int capacity = value.capacity();
+    const string large = power(BigInteger(3), 2000).to_string();
+    read = Chars::from_chars(large.data(), large.data() + large.size(), value);
+    assert(read.ec == std::errc() && value.capacity() == capacity && value.to_string() == large);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_ingest() {
+
+    cout << "\nTesting bulk ingest - ";
+
+    // lines of every length up to 600 digits, every 7th one broken, spread over several tasks
+    string text;
+    vector<BigInteger> expected;
+    vector<size_t> invalid;
+    BigInteger value(-3);
+    for (size_t line = 0; line < 3000; line++) {
+        value *= line % 2 == 0 ? -7 : 5;
+        if (value.size() > 250)
+            value = BigInteger(static_cast<long>(line));
+        string decimal = value.to_string();
+        if (line % 7 == 3) {
+            decimal.insert(decimal.size() / 2, line % 2 == 0 ? "x" : "+");
+            invalid.push_back(line);
+            expected.push_back(0);
+        } else {
+            expected.push_back(value);
+        }
+        text += decimal + (line % 5 == 0 ? "\r\n" : "\n");
+    }
+
+    BigIntegerThreadPool inline_pool(0), pool_of_three(3);
+    BigIntegerThreadPool *pools[] = {&inline_pool, &pool_of_three};
+    for (BigIntegerThreadPool *pool : pools) {
+        const BigIntegerIngest::Result result = BigIntegerIngest::parse_lines(text.data(), text.data() + text.size(),
+                                                                              *pool);
+        assert(result.values == expected && result.errors.size() == invalid.size());
+        for (size_t i = 0; i < invalid.size(); i++)
+            assert(result.errors[i].line == invalid[i] && result.errors[i].ec == std::errc::invalid_argument);
+    }
+
+    const char *path = "BigIntegerIngest.test.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "12\n-\n\n 5\n-99999999999999999999999\n7z\n42";
+    }
+    BigIntegerIngest::Result result;
+    assert(BigIntegerIngest::parse_file(path, result, pool_of_three));
+    std::remove(path);
+    assert(result.values.size() == 7 && result.values[0] == 12 && result.values[6] == 42);
+    assert(result.values[4] == BigInteger("-99999999999999999999999") && result.values[5] == 0);
+    assert(result.errors.size() == 4 && result.errors[3].line == 5 && result.errors[3].column == 1);
+    assert(result.errors[0].line == 1 && result.errors[1].line == 2 && result.errors[2].column == 0);
+    assert(!BigIntegerIngest::parse_file("no/such/file.txt", result));
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_power_cache() {
+
+    cout << "\nTesting power cache - ";
+
+    BigInteger expected(1);
+    for (int k = 0; k < 4; k++) {
+        for (int i = 0; i < (BigInteger::DIGITS_IN_WORD << k) - (k == 0 ? 0 : BigInteger::DIGITS_IN_WORD << (k - 1)); i++)
+            expected *= 10;
+        const BigInteger *level = BigIntegerPowerCache::level(static_cast<unsigned int>(k));
+        assert(level != nullptr && *level == expected);
+        assert(BigIntegerPowerCache::level(static_cast<unsigned int>(k)) == level);
+    }
+
+    BigInteger ten_to(1);
+    for (unsigned int exponent = 0; exponent < 300; exponent++, ten_to *= 10)
+        assert(BigIntegerPowerCache::power_of_ten(exponent) == ten_to && power(BigInteger(10), exponent) == ten_to);
+
+    // readers racing for a level see one value
+    const BigInteger *seen[4] = {};
+    vector<std::thread> readers;
+    for (const BigInteger *&level : seen)
+        readers.emplace_back([&level]() { level = BigIntegerPowerCache::level(8); });
+    for (std::thread &reader : readers)
+        reader.join();
+    for (const BigInteger *level : seen)
+        assert(level == seen[0] && level != nullptr);
+
+    // the levels over the limit are left to the caller
+    assert(BigIntegerPowerCache::level(BigIntegerPowerCache::MAX_LEVELS - 1) == nullptr);
+    const size_t used = BigIntegerPowerCache::memory_used();
+    BigIntegerPowerCache::set_memory_limit(used);
+    assert(BigIntegerPowerCache::level(12) == nullptr || BigIntegerPowerCache::memory_used() == used);
+    const BigInteger big = power(BigInteger("12345678901234567890"), 2000);
+    assert(BigIntegerConversion::parse(BigIntegerConversion::to_string(big)) == big);
+    assert(BigIntegerPowerCache::memory_used() == used);
+    BigIntegerPowerCache::set_memory_limit(static_cast<size_t>(64) << 20);
+
+    BigIntegerPowerCache::warm_up(BigInteger::DIGITS_IN_WORD * 1024 + 1);
+    assert(BigIntegerPowerCache::level(10) != nullptr);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_gcd() {
+
+    cout << "\nTesting gcd - ";
+
+    assert(gcd(BigInteger(0), BigInteger(0)) == BigInteger::ZERO);
+    assert(gcd(BigInteger(0), BigInteger(-7)) == BigInteger(7));
+    assert(gcd(BigInteger(12), BigInteger(-18)) == BigInteger(6));
+
+    const BigInteger p("170141183460469231731687303715884105727");
+    const BigInteger q("618970019642690137449562111");
+    const BigInteger r("1000000007");
+    assert(gcd(p * q, q * r) == q);
+    assert(gcd(-(p * r * r), p * q * r) == p * r);
+    assert(gcd(p, q) == BigInteger::ONE);
+    assert(gcd(power(BigInteger(2), 300), power(BigInteger(6), 100)) == power(BigInteger(2), 100));
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_rational() {
+
+    cout << "\nTesting rational - ";
+
+    const BigRational half(1, 2), third(BigInteger(-2), BigInteger(-6));
+    assert((half + third).to_string() == "5/6");
+    assert((half - third).to_string() == "1/6");
+    assert((half * third).to_string() == "1/6");
+    assert((half / third).to_string() == "3/2");
+    assert((third - half * 2).to_string() == "-2/3");
+    assert(BigRational(BigInteger(10), BigInteger(-4)).to_string() == "-5/2");
+    assert(BigRational(BigInteger(-12), BigInteger(4)).to_string() == "-3");
+    assert((half - half).to_string() == "0");
+
+    assert(half > third && third < half && -half < third);
+    assert(BigRational(BigInteger(2), BigInteger(4)) == half);
+    assert(BigRational(BigInteger(2), BigInteger(4)) != third);
+
+    // the harmonic number H(200) stays exact through lazy reduction
+    BigRational harmonic(0);
+    for (long i = 1; i <= 200; i++)
+        harmonic += BigRational(BigInteger(1), BigInteger(i));
+    BigRational lowest(harmonic);
+    lowest.reduce();
+    assert(lowest == harmonic && lowest.is_reduced());
+    assert(lowest.numerator().size() < 40 && gcd(lowest.numerator(), lowest.denominator()) == BigInteger::ONE);
+
+    // cross-cancellation keeps a product of reduced fractions reduced
+    BigRational product(1);
+    for (long i = 1; i <= 100; i++) {
+        BigRational factor(BigInteger(i + 1), BigInteger(i));
+        product *= factor.reduce();
+    }
+    assert(product.is_reduced() && product.to_string() == "101");
+
+    BigRational square(BigInteger(-3), BigInteger(7));
+    square *= square;
+    assert(square.to_string() == "9/49");
+
+    bool thrown = false;
+    try {
+        BigRational(BigInteger(1), BigInteger(0));
+    } catch (const BigInteger::BigIntegerException &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        half / BigRational(0);
+    } catch (const BigInteger::BigIntegerException &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_decimal() {
+
+    cout << "\nTesting decimal - ";
+
+    using Rounding = BigDecimal::Rounding;
+
+    assert(BigDecimal("-123.4500").scale() == 4 && BigDecimal("-123.4500").unscaled() == BigInteger(-1234500));
+    assert(BigDecimal("-123.4500").to_string() == "-123.4500");
+    assert(BigDecimal("0.05").to_string() == "0.05");
+    assert(BigDecimal("-.5").to_string() == "-0.5");
+    assert(BigDecimal("7.").to_string() == "7");
+    assert(BigDecimal(BigInteger(42), -3).to_string() == "42000");
+    assert(BigDecimal(BigInteger(-42), 5).to_string() == "-0.00042");
+
+    assert((BigDecimal("1.10") + BigDecimal("2.205")).to_string() == "3.305");
+    assert((BigDecimal("1.10") - BigDecimal("2.205")).to_string() == "-1.105");
+    assert((BigDecimal("1.5") * BigDecimal("-0.25")).to_string() == "-0.375");
+    assert(BigDecimal("1.10") == BigDecimal("1.1") && BigDecimal("1.09") < BigDecimal("1.1"));
+    assert(BigDecimal("-2") < BigDecimal("1.5") && BigDecimal("100") > BigDecimal("99.999999"));
+
+    const char *values[] = {"2.5", "3.5", "-2.5", "-3.5", "2.51", "-2.49", "2.4999"};
+    const char *half_even[] = {"2", "4", "-2", "-4", "3", "-2", "2"};
+    const char *half_up[] = {"3", "4", "-3", "-4", "3", "-2", "2"};
+    const char *floor[] = {"2", "3", "-3", "-4", "2", "-3", "2"};
+    const char *ceiling[] = {"3", "4", "-2", "-3", "3", "-2", "3"};
+    for (int i = 0; i < 7; i++) {
+        BigDecimal a(values[i]), b(values[i]), c(values[i]), d(values[i]);
+        assert(a.set_scale(0, Rounding::HALF_EVEN).to_string() == half_even[i]);
+        assert(b.set_scale(0, Rounding::HALF_UP).to_string() == half_up[i]);
+        assert(c.set_scale(0, Rounding::FLOOR).to_string() == floor[i]);
+        assert(d.set_scale(0, Rounding::CEILING).to_string() == ceiling[i]);
+    }
+
+    BigDecimal price("19.99");
+    assert(price.set_scale(5).to_string() == "19.99000");
+    assert(price.set_scale(1).to_string() == "20.0");
+
+    // rescaling past one machine word goes through the shared powers of ten
+    BigDecimal tiny(BigInteger("123456789"), 40);
+    assert(tiny.set_scale(32, Rounding::CEILING).to_string() == "0.00000000000000000000000000000002");
+    BigDecimal large(BigInteger("15"), 1);
+    assert(large.set_scale(30).set_scale(0).to_string() == "2");
+
+    BigDecimal third("1");
+    assert(third.divide(BigDecimal("3"), 10).to_string() == "0.3333333333");
+    BigDecimal two_thirds("-2.00");
+    assert(two_thirds.divide(BigDecimal("3"), 4, Rounding::HALF_UP).to_string() == "-0.6667");
+    BigDecimal rate("100");
+    assert(rate.divide(BigDecimal("0.0008"), -3, Rounding::FLOOR).to_string() == "125000");
+
+    bool thrown = false;
+    try {
+        third.divide(BigDecimal("0.00"), 2);
+    } catch (const BigInteger::BigIntegerException &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        BigDecimal("1.2.3");
+    } catch (const BigInteger::BigIntegerException &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "SUCCESS!\n";
+}
+
+static bool cancelled(std::future<BigInteger> &result) {
+    try {
+        result.get();
+    } catch (const BigInteger::BigIntegerException &e) {
+        return e.get_error_message() == "Operation cancelled";
+    }
+    return false;
+}
+
+void BigIntegerTester::test_rns() {
+
+    cout << "\nTesting residue number system - ";
+
+    const std::shared_ptr<const BigRNS::Basis> basis = BigRNS::Basis::for_bits(2000);
+    assert(basis->bits() >= 2000 && basis->size() == 33);
+    for (uint64_t prime : basis->primes())
+        assert(prime < (static_cast<uint64_t>(1) << 62) && prime > (static_cast<uint64_t>(1) << 61));
+    assert(BigRNS::Basis(3).primes()[2] == basis->primes()[2]);
+
+    const BigInteger a("-123456789012345678901234567890123456789012345678901234567890");
+    const BigInteger b("987654321098765432109876543210987654321");
+    assert(BigRNS(a, basis).to_big_integer() == a);
+    assert(BigRNS(b, basis).to_big_integer() == b);
+    assert(BigRNS(0, basis).to_big_integer() == BigInteger::ZERO);
+    assert(BigRNS(-1, basis).to_big_integer() == BigInteger(-1));
+    assert((-BigRNS(b, basis)).to_big_integer() == -b);
+    assert(BigRNS(a, basis).residues()[0] == a.remainder(basis->primes()[0]));
+
+    // the whole Horner scheme without a carry, read out once
+    BigRNS x(b, basis), p(a, basis);
+    BigInteger expected(a);
+    for (int i = 0; i < 12; i++) {
+        p *= x;
+        p -= BigRNS(i * 1000003L, basis);
+        expected = expected * b - BigInteger(i * 1000003L);
+    }
+    assert(expected.bit_length() < 2000);
+    assert(p.to_big_integer() == expected);
+    assert(BigRNS(expected, basis) == p && BigRNS(expected + 1, basis) != p);
+    assert((BigRNS(a, basis) + BigRNS(b, basis) * BigRNS(b, basis)).to_big_integer() == a + b * b);
+
+    // past the range the value wraps around modulo M
+    assert(BigRNS(basis->modulus() + a, basis).to_big_integer() == a);
+
+    // enough primes for the conversions to split into tasks
+    BigIntegerThreadPool pool(2);
+    const std::shared_ptr<const BigRNS::Basis> wide = BigRNS::Basis::for_bits(20000);
+    const BigInteger big = power(a, 90) + b;
+    const BigRNS converted(big, wide, pool);
+    assert(converted.to_big_integer(pool) == big);
+    assert((converted * BigRNS(-3, wide)).to_big_integer(pool) == big * -3);
+
+    // the pool of a value carries over to what is computed from it
+    const BigRNS product = converted * BigRNS(-3, wide);
+    assert(&product.pool() == &pool && &BigRNS(-3, wide).pool() == &BigIntegerThreadPool::shared());
+    assert(product.to_big_integer() == big * -3 && &(-product).pool() == &pool);
+
+    bool thrown = false;
+    try {
+        x += converted;
+    } catch (BigInteger::BigIntegerException &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "SUCCESS!\n";
+}
+
+void BigIntegerTester::test_async() {
+
+    cout << "\nTesting async operations - ";
+
+    BigIntegerThreadPool pool(2);
+    BigIntegerAsync::Options options;
+    options.executor = &pool;
+
+    const BigInteger a("123456789012345678901234567890"), b("-987654321");
+    assert(BigIntegerAsync::multiply(a, b, options).get() == a * b);
+    assert(BigIntegerAsync::divide(a, b, options).get() == a / b);
+    assert(BigIntegerAsync::power(b, 7, options).get() == power(b, 7));
+    assert(BigIntegerAsync::to_string(a, options).get() == a.to_string());
+    assert(BigIntegerAsync::run([&a]() { return gcd(a, a * 3); }, options).get() == a);
+
+    BigIntegerThreadPool inline_pool(0);
+    BigIntegerAsync::Options inline_options;
+    inline_options.executor = &inline_pool;
+    std::future<BigInteger> waited = BigIntegerAsync::multiply(a, a, inline_options);
+    assert(inline_pool.wait(waited) == a * a);
+
+    // cancelled before it starts
+    BigIntegerAsync::Options cancelled_options(options);
+    cancelled_options.cancellation = BigIntegerCancellation();
+    cancelled_options.cancellation.cancel();
+    std::future<BigInteger> never = BigIntegerAsync::power(BigInteger(3), 5000000, cancelled_options);
+    assert(cancelled(never));
+
+    // cancelled by its own progress report, stops at the next checkpoint
+    vector<double> reports;
+    BigIntegerAsync::Options reporting(options);
+    reporting.cancellation = BigIntegerCancellation();
+    reporting.progress = [&reports, &reporting](double fraction) {
+        reports.push_back(fraction);
+        if (reports.size() == 3)
+            reporting.cancellation.cancel();
+    };
+    std::future<BigInteger> stopped = BigIntegerAsync::power(BigInteger(3), 5000000, reporting);
+    assert(cancelled(stopped));
+    assert(reports.size() == 3 && reports[0] > 0 && reports[0] < reports[1] && reports[1] < reports[2]);
+
+    // a deadline
+    BigIntegerAsync::Options deadline(options);
+    deadline.cancellation = BigIntegerCancellation();
+    deadline.cancellation.cancel_at(BigIntegerCancellation::Clock::now() + std::chrono::milliseconds(20));
+    std::future<BigInteger> late = BigIntegerAsync::power(BigInteger(7), 5000000, deadline);
+    assert(cancelled(late));
+
+    cout << "SUCCESS!\n";
+}
@@ -5,16 +5,20 @@
 
 #pragma once
 
+#include <random>
+#include <thread>
+#include <vector>
 #include "BigInteger.h"
+#include "BigIntegerReference.h"
 
 
 class BigIntegerTester {
 
 private:
 
-    using binary_operator = BigInteger (*const)(BigInteger, const BigInteger &);
-    using shift_operator = BigInteger (*const)(BigInteger, unsigned int);
-    using cmp_operator = bool (*const)(const BigInteger &, const BigInteger &);
+    using binary_operator = BigInteger (*)(BigInteger, const BigInteger &);
+    using shift_operator = BigInteger (*)(BigInteger, unsigned int);
+    using cmp_operator = bool (*)(const BigInteger &, const BigInteger &);
 
     static void assert_expression(const string &a, binary_operator, const string &b, const string &ans);
 
@@ -26,6 +30,10 @@ private:
 
     static void assert_power_expression(const string &a, unsigned int pow, const string &ans);
 
+    static reference::Number random_reference_number(std::mt19937 &, int max_bytes);
+
+    static bool cross_check(const char *what, const BigInteger &a, const BigInteger &b, bool ok);
+
 public:
 
     static void test_all();
@@ -47,4 +55,47 @@ public:
     static void test_self_operator();
 
     static void test_power();
+
+    static void test_bitwise();
+
+    static void test_magnitude();
+
+    static void test_random();
+
+    static void test_word_operators();
+
+    static void test_accumulator();
+
+    static void test_kernels();
+
+    static void test_thresholds();
+
+    static void test_capacity();
+
+    static void test_copy_on_write();
+
+    static void test_hash();
+
+    static void test_parallel_conversion();
+
+    static void test_chars();
+
+    static void test_ingest();
+
+    static void test_power_cache();
+
+    static void test_gcd();
+
+    static void test_rational();
+
+    static void test_decimal();
+
+    static void test_rns();
+
+    static void test_async();
+
+    static void test_stats();
+
+    // compares fast paths with reference:: algorithms on random operands, returns the number of mismatches
+    static int test_cross_check(unsigned int seed, int rounds, int max_bytes);
 };
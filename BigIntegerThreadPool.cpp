@@ -0,0 +1,77 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include "BigIntegerThreadPool.h"
+
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::function;
+
+BigIntegerThreadPool::BigIntegerThreadPool(const unsigned int threads) :
+        _lock(),
+        _ready(),
+        _tasks(),
+        _workers(),
+        _stopping(false) {
+
+    _workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; i++)
+        _workers.emplace_back(&BigIntegerThreadPool::work, this);
+}
+
+BigIntegerThreadPool::~BigIntegerThreadPool() {
+    {
+        lock_guard<mutex> guard(_lock);
+        _stopping = true;
+    }
+    _ready.notify_all();
+    for (std::thread &worker : _workers)
+        worker.join();
+}
+
+void BigIntegerThreadPool::enqueue(function<void()> task) {
+    {
+        lock_guard<mutex> guard(_lock);
+        _tasks.push_back(std::move(task));
+    }
+    _ready.notify_one();
+}
+
+bool BigIntegerThreadPool::run_pending() {
+    function<void()> task;
+    {
+        lock_guard<mutex> guard(_lock);
+        if (_tasks.empty())
+            return false;
+        // the newest task is the smallest part of the latest split
+        task = std::move(_tasks.back());
+        _tasks.pop_back();
+    }
+    task();
+    return true;
+}
+
+void BigIntegerThreadPool::work() {
+    for (;;) {
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(_lock);
+            _ready.wait(guard, [this]() { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty())
+                return;
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
+
+BigIntegerThreadPool &BigIntegerThreadPool::shared() {
+    static BigIntegerThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
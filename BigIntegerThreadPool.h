@@ -0,0 +1,75 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using std::vector;
+
+
+// Fixed set of worker threads running queued tasks. A thread waiting for a task through
+// wait() runs queued tasks meanwhile, so tasks may split themselves and wait for the parts
+// without exhausting the workers. A pool of zero threads runs everything inside wait().
+class BigIntegerThreadPool {
+
+public:
+
+    explicit BigIntegerThreadPool(unsigned int threads);
+
+    BigIntegerThreadPool(const BigIntegerThreadPool &) = delete;
+
+    BigIntegerThreadPool &operator=(const BigIntegerThreadPool &) = delete;
+
+    ~BigIntegerThreadPool();
+
+    unsigned int threads() const &{ return static_cast<unsigned int>(_workers.size()); }
+
+    template<typename Task>
+    std::future<typename std::result_of<Task()>::type> submit(Task task) {
+        using Result = typename std::result_of<Task()>::type;
+        std::shared_ptr<std::packaged_task<Result()>> packaged =
+                std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    template<typename Result>
+    Result wait(std::future<Result> &future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // an empty queue means a worker has taken the task, and it will finish it
+            if (!run_pending())
+                future.wait();
+        }
+        return future.get();
+    }
+
+    // runs one queued task on the calling thread, false if there was none
+    bool run_pending();
+
+    // one worker per hardware thread, created on first use
+    static BigIntegerThreadPool &shared();
+
+private:
+
+    std::mutex _lock;
+    std::condition_variable _ready;
+    std::deque<std::function<void()>> _tasks;
+    vector<std::thread> _workers;
+    bool _stopping;
+
+    void enqueue(std::function<void()>);
+
+    void work();
+};
@@ -0,0 +1,129 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "BigIntegerThresholds.h"
+
+#if defined(BIGINTEGER_TUNING_HEADER)
+#include BIGINTEGER_TUNING_HEADER
+#endif
+
+#ifndef BIGINTEGER_THRESHOLD_MUL_KARATSUBA
+#define BIGINTEGER_THRESHOLD_MUL_KARATSUBA 32
+#endif
+#ifndef BIGINTEGER_THRESHOLD_SQR_KARATSUBA
+#define BIGINTEGER_THRESHOLD_SQR_KARATSUBA 48
+#endif
+#ifndef BIGINTEGER_THRESHOLD_ADD_LIMBS
+#define BIGINTEGER_THRESHOLD_ADD_LIMBS 4
+#endif
+#ifndef BIGINTEGER_THRESHOLD_CONVERSION_LEAF
+#define BIGINTEGER_THRESHOLD_CONVERSION_LEAF 256
+#endif
+
+using std::atomic;
+
+struct Limits {
+    const char *name;
+    const char *macro;
+    size_t fallback;
+    size_t minimum;
+};
+
+static const Limits LIMITS[BigIntegerThresholds::COUNT] = {
+        {"mul_karatsuba",   "BIGINTEGER_THRESHOLD_MUL_KARATSUBA",   BIGINTEGER_THRESHOLD_MUL_KARATSUBA,   2},
+        {"sqr_karatsuba",   "BIGINTEGER_THRESHOLD_SQR_KARATSUBA",   BIGINTEGER_THRESHOLD_SQR_KARATSUBA,   2},
+        {"add_limbs",       "BIGINTEGER_THRESHOLD_ADD_LIMBS",       BIGINTEGER_THRESHOLD_ADD_LIMBS,       1},
+        {"conversion_leaf", "BIGINTEGER_THRESHOLD_CONVERSION_LEAF", BIGINTEGER_THRESHOLD_CONVERSION_LEAF, 8}
+};
+
+// constant-initialized before any dynamic initialization, so usable from static constructors
+static atomic<size_t> values[BigIntegerThresholds::COUNT] = {
+        {BIGINTEGER_THRESHOLD_MUL_KARATSUBA},
+        {BIGINTEGER_THRESHOLD_SQR_KARATSUBA},
+        {BIGINTEGER_THRESHOLD_ADD_LIMBS},
+        {BIGINTEGER_THRESHOLD_CONVERSION_LEAF}
+};
+
+static bool load_environment() {
+    const char *path = std::getenv("BIGINTEGER_TUNING");
+    return path != nullptr && BigIntegerThresholds::load(path);
+}
+
+static const bool LOADED_FROM_ENVIRONMENT = load_environment();
+
+size_t BigIntegerThresholds::get(const Threshold threshold) {
+    return values[threshold].load(std::memory_order_relaxed);
+}
+
+void BigIntegerThresholds::set(const Threshold threshold, const size_t value) {
+    values[threshold].store(std::max(value, LIMITS[threshold].minimum), std::memory_order_relaxed);
+}
+
+void BigIntegerThresholds::reset() {
+    for (int i = 0; i < COUNT; i++)
+        set(static_cast<Threshold>(i), LIMITS[i].fallback);
+}
+
+const char *BigIntegerThresholds::name(const Threshold threshold) {
+    return LIMITS[threshold].name;
+}
+
+bool BigIntegerThresholds::load(const string &path) {
+
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    size_t loaded[COUNT];
+    bool present[COUNT] = {};
+
+    string line;
+    while (std::getline(file, line)) {
+        line.erase(std::find(line.begin(), line.end(), '#'), line.end());
+        std::replace(line.begin(), line.end(), '=', ' ');
+        std::istringstream fields(line);
+        string key, rest;
+        long long value;
+        if (!(fields >> key))
+            continue;
+        if (!(fields >> value) || value < 0 || (fields >> rest))
+            return false;
+
+        int i = 0;
+        while (i < COUNT && key != LIMITS[i].name)
+            i++;
+        if (i == COUNT)
+            return false;
+        loaded[i] = static_cast<size_t>(value);
+        present[i] = true;
+    }
+
+    for (int i = 0; i < COUNT; i++) {
+        if (present[i])
+            set(static_cast<Threshold>(i), loaded[i]);
+    }
+    return true;
+}
+
+string BigIntegerThresholds::config() {
+    std::ostringstream out;
+    for (int i = 0; i < COUNT; i++)
+        out << LIMITS[i].name << " = " << get(static_cast<Threshold>(i)) << "\n";
+    return out.str();
+}
+
+string BigIntegerThresholds::header() {
+    std::ostringstream out;
+    out << "// Generated by BigInteger_tune, see BigIntegerThresholds.h\n\n#pragma once\n\n";
+    for (int i = 0; i < COUNT; i++)
+        out << "#define " << LIMITS[i].macro << " " << get(static_cast<Threshold>(i)) << "\n";
+    return out.str();
+}
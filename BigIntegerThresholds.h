@@ -0,0 +1,52 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+using std::string;
+
+
+// Process-wide crossover sizes between the algorithm tiers, measured for the host by
+// BigInteger_tune. The defaults are compiled in, from the header it writes when the
+// BIGINTEGER_TUNING_HEADER CMake option names one; at startup a config file it writes,
+// named by the BIGINTEGER_TUNING environment variable, overrides them.
+class BigIntegerThresholds {
+
+public:
+
+    enum Threshold {
+        // limbs of the smaller factor from which mpn::mul uses Karatsuba
+        MUL_KARATSUBA,
+        // limbs from which mpn::sqr uses Karatsuba
+        SQR_KARATSUBA,
+        // words of the longer operand from which BigInteger::operator+= adds words, not bytes
+        ADD_LIMBS,
+        // bytes up to which BigIntegerConversion converts a part a word at a time
+        CONVERSION_LEAF,
+        COUNT
+    };
+
+    static size_t get(Threshold);
+
+    // raised to the smallest value the algorithms accept
+    static void set(Threshold, size_t);
+
+    // back to the compiled-in defaults
+    static void reset();
+
+    static const char *name(Threshold);
+
+    // "name = value" lines, '#' starts a comment; nothing changes unless the whole file is valid
+    static bool load(const string &path);
+
+    // the current values in the format load() reads
+    static string config();
+
+    // the current values as a header for BIGINTEGER_TUNING_HEADER
+    static string header();
+};
@@ -0,0 +1,333 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include "BigRNS.h"
+#include "BigIntegerKernels.h"
+
+using std::future;
+
+const size_t BigRNS::TASK_RESIDUES;
+const size_t BigRNS::TASK_PRIMES;
+const size_t BigRNS::LEAF_PRIMES;
+
+static const uint64_t PRIME_LIMIT = static_cast<uint64_t>(1) << 62;
+
+BigRNS::Basis::Reducer BigRNS::Basis::reducer(const uint64_t prime) {
+    const int shift = mpn::leading_zeros(prime);
+    return {shift, prime << shift, mpn::reciprocal(prime << shift)};
+}
+
+// the product shifted as the prime was, so that its high word stays below the normalized prime
+uint64_t BigRNS::Basis::multiply(const uint64_t a, const uint64_t b, const Reducer &reducer) {
+    uint64_t high, low, remainder;
+    mpn::mul_words(a, b, high, low);
+    if (reducer.shift != 0) {
+        high = (high << reducer.shift) | (low >> (64 - reducer.shift));
+        low <<= reducer.shift;
+    }
+    mpn::divide_words(high, low, reducer.normalized, reducer.inverse, remainder);
+    return remainder >> reducer.shift;
+}
+
+uint64_t BigRNS::Basis::power(uint64_t a, uint64_t exponent, const uint64_t prime, const Reducer &reducer) {
+    uint64_t ans = 1 % prime;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1u)
+            ans = multiply(ans, a, reducer);
+        a = multiply(a, a, reducer);
+    }
+    return ans;
+}
+
+// Miller-Rabin with the first twelve primes as bases, deterministic below 2^64
+bool BigRNS::Basis::is_prime(const uint64_t n) {
+
+    static const uint64_t BASES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+    for (uint64_t base : BASES) {
+        if (n % base == 0)
+            return n == base;
+    }
+
+    const Reducer r = reducer(n);
+    uint64_t odd = n - 1;
+    int twos = 0;
+    for (; odd % 2 == 0; odd /= 2)
+        twos++;
+
+    for (uint64_t base : BASES) {
+        uint64_t x = power(base, odd, n, r);
+        if (x == 1 || x == n - 1)
+            continue;
+        int i = 1;
+        for (; i < twos && x != n - 1; i++)
+            x = multiply(x, x, r);
+        if (x != n - 1)
+            return false;
+    }
+    return true;
+}
+
+vector<uint64_t> BigRNS::Basis::largest_primes(const size_t count) {
+
+    static std::mutex lock;
+    static vector<uint64_t> primes;
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (uint64_t candidate = primes.empty() ? PRIME_LIMIT - 1 : primes.back() - 2; primes.size() < count;
+         candidate -= 2) {
+        if (is_prime(candidate))
+            primes.push_back(candidate);
+    }
+    return vector<uint64_t>(primes.begin(), primes.begin() + static_cast<long>(count));
+}
+
+BigRNS::Basis::Basis(const size_t count) :
+        _primes(largest_primes(std::max<size_t>(count, 1))),
+        _reducers(),
+        _crt(),
+        _tree(4 * _primes.size()) {
+
+    for (uint64_t prime : _primes)
+        _reducers.push_back(reducer(prime));
+
+    build(1, 0, _primes.size());
+
+    // M / p_i modulo p_i is the product of the other primes, inverted by Fermat
+    for (size_t i = 0; i < _primes.size(); i++) {
+        uint64_t cofactor = 1;
+        for (size_t j = 0; j < _primes.size(); j++) {
+            if (j != i)
+                cofactor = multiply(cofactor, _primes[j] % _primes[i], _reducers[i]);
+        }
+        _crt.push_back(power(cofactor, _primes[i] - 2, _primes[i], _reducers[i]));
+    }
+}
+
+void BigRNS::Basis::build(const size_t node, const size_t first, const size_t last) {
+    if (last - first == 1) {
+        _tree[node] = BigInteger(0) + _primes[first];
+        return;
+    }
+    const size_t middle = first + (last - first) / 2;
+    build(2 * node, first, middle);
+    build(2 * node + 1, middle, last);
+    _tree[node] = _tree[2 * node] * _tree[2 * node + 1];
+}
+
+std::shared_ptr<const BigRNS::Basis> BigRNS::Basis::for_bits(const unsigned int bits) {
+    // every prime is above 2^61, so count of them hold at least 61 count - 1 bits
+    return std::make_shared<const Basis>((static_cast<size_t>(bits) + 2) / 61 + 1);
+}
+
+uint64_t BigRNS::Basis::multiply(const uint64_t a, const uint64_t b, const size_t i) const &{
+    return multiply(a, b, _reducers[i]);
+}
+
+BigRNS::BigRNS(const BigInteger &value, std::shared_ptr<const Basis> basis, BigIntegerThreadPool &pool) :
+        _basis(std::move(basis)),
+        _residues(_basis->size()),
+        _pool(&pool) {
+
+    BigInteger magnitude(value);
+    if (magnitude.is_neg())
+        magnitude.negate();
+
+    // the remainder modulo M first, then down the tree of products
+    BigInteger remainder;
+    BigInteger::divide_positive(magnitude, _basis->modulus(), remainder);
+    reduce(std::move(remainder), 1, 0, _residues.size(), pool);
+
+    if (value.is_neg())
+        negate();
+}
+
+BigRNS::BigRNS(const long value, std::shared_ptr<const Basis> basis, BigIntegerThreadPool &pool) :
+        BigRNS(BigInteger(value), std::move(basis), pool) {}
+
+void BigRNS::reduce(BigInteger magnitude, const size_t node, const size_t first, const size_t last,
+                    BigIntegerThreadPool &pool) {
+
+    if (last - first <= LEAF_PRIMES) {
+        for (size_t i = first; i < last; i++)
+            _residues[i] = magnitude.remainder(_basis->_primes[i]);
+        return;
+    }
+
+    const size_t middle = first + (last - first) / 2;
+    BigInteger low, high;
+    BigInteger::divide_positive(magnitude, _basis->_tree[2 * node], low);
+    BigInteger::divide_positive(magnitude, _basis->_tree[2 * node + 1], high);
+    magnitude = BigInteger();
+
+    if (last - first < TASK_PRIMES) {
+        reduce(std::move(low), 2 * node, first, middle, pool);
+        reduce(std::move(high), 2 * node + 1, middle, last, pool);
+        return;
+    }
+
+    // the halves write disjoint residues
+    future<void> task = pool.submit([this, &low, node, first, middle, &pool]() {
+        reduce(std::move(low), 2 * node, first, middle, pool);
+    });
+    try {
+        reduce(std::move(high), 2 * node + 1, middle, last, pool);
+    } catch (...) {
+        task.wait();
+        throw;
+    }
+    pool.wait(task);
+}
+
+BigRNS &BigRNS::negate() &{
+    const vector<uint64_t> &primes = _basis->_primes;
+    for (size_t i = 0; i < _residues.size(); i++)
+        _residues[i] = _residues[i] == 0 ? 0 : primes[i] - _residues[i];
+    return *this;
+}
+
+// runs operation(first, last) over the residues, in tasks on the pool of the value when there are many
+template<typename Operation>
+BigRNS &BigRNS::apply(const BigRNS &b, Operation operation) {
+
+    if (_basis != b._basis && _basis->_primes != b._basis->_primes)
+        throw BigInteger::BigIntegerException("Different RNS bases");
+
+    const size_t count = _residues.size();
+    if (count < 2 * TASK_RESIDUES) {
+        operation(0, count);
+        return *this;
+    }
+
+    BigIntegerThreadPool &pool = *_pool;
+    vector<future<void>> tasks;
+    for (size_t first = TASK_RESIDUES; first < count; first += TASK_RESIDUES) {
+        const size_t last = std::min(count, first + TASK_RESIDUES);
+        tasks.push_back(pool.submit([operation, first, last]() { operation(first, last); }));
+    }
+    operation(0, TASK_RESIDUES);
+    for (future<void> &task : tasks)
+        pool.wait(task);
+
+    return *this;
+}
+
+// the residues stay below 2^62, so the sums cannot overflow and the loops have no branches
+BigRNS &BigRNS::operator+=(const BigRNS &b) &{
+    uint64_t *x = _residues.data();
+    const uint64_t *y = b._residues.data();
+    const uint64_t *p = _basis->_primes.data();
+    return apply(b, [x, y, p](const size_t first, const size_t last) {
+        for (size_t i = first; i < last; i++) {
+            const uint64_t sum = x[i] + y[i];
+            x[i] = sum >= p[i] ? sum - p[i] : sum;
+        }
+    });
+}
+
+BigRNS &BigRNS::operator-=(const BigRNS &b) &{
+    uint64_t *x = _residues.data();
+    const uint64_t *y = b._residues.data();
+    const uint64_t *p = _basis->_primes.data();
+    return apply(b, [x, y, p](const size_t first, const size_t last) {
+        for (size_t i = first; i < last; i++) {
+            const uint64_t difference = x[i] + p[i] - y[i];
+            x[i] = difference >= p[i] ? difference - p[i] : difference;
+        }
+    });
+}
+
+BigRNS &BigRNS::operator*=(const BigRNS &b) &{
+    uint64_t *x = _residues.data();
+    const uint64_t *y = b._residues.data();
+    const Basis::Reducer *reducers = _basis->_reducers.data();
+    return apply(b, [x, y, reducers](const size_t first, const size_t last) {
+        for (size_t i = first; i < last; i++)
+            x[i] = Basis::multiply(x[i], y[i], reducers[i]);
+    });
+}
+
+BigInteger BigRNS::to_big_integer() const &{
+    return to_big_integer(*_pool);
+}
+
+// x = sum y_i M / p_i with y_i = r_i (M / p_i)^-1 modulo p_i, below k M, taken modulo M
+BigInteger BigRNS::to_big_integer(BigIntegerThreadPool &pool) const &{
+
+    const Basis &basis = *_basis;
+    vector<uint64_t> y(_residues.size());
+    for (size_t i = 0; i < y.size(); i++)
+        y[i] = basis.multiply(_residues[i], basis._crt[i], i);
+
+    BigInteger remainder;
+    BigInteger::divide_positive(combine(y, 1, 0, y.size(), pool), basis.modulus(), remainder);
+
+    if ((remainder << 1) >= basis.modulus())
+        remainder -= basis.modulus();
+    return remainder;
+}
+
+// sum y_i M_node / p_i over the primes of the node
+BigInteger BigRNS::combine(const vector<uint64_t> &y, const size_t node, const size_t first, const size_t last,
+                           BigIntegerThreadPool &pool) const {
+
+    if (last - first == 1)
+        return BigInteger(0) + y[first];
+
+    const size_t middle = first + (last - first) / 2;
+    BigInteger low, high;
+    if (last - first < TASK_PRIMES) {
+        low = combine(y, 2 * node, first, middle, pool);
+        high = combine(y, 2 * node + 1, middle, last, pool);
+    } else {
+        future<BigInteger> task = pool.submit([this, &y, node, first, middle, &pool]() {
+            return combine(y, 2 * node, first, middle, pool);
+        });
+        try {
+            high = combine(y, 2 * node + 1, middle, last, pool);
+        } catch (...) {
+            task.wait();
+            throw;
+        }
+        low = pool.wait(task);
+    }
+
+    low *= _basis->_tree[2 * node + 1];
+    high *= _basis->_tree[2 * node];
+    low += high;
+    return low;
+}
+
+bool operator==(const BigRNS &a, const BigRNS &b) {
+    return a._basis->primes() == b._basis->primes() && a._residues == b._residues;
+}
+
+bool operator!=(const BigRNS &a, const BigRNS &b) {
+    return !(a == b);
+}
+
+BigRNS operator+(BigRNS a, const BigRNS &b) {
+    a += b;
+    return a;
+}
+
+BigRNS operator-(BigRNS a, const BigRNS &b) {
+    a -= b;
+    return a;
+}
+
+BigRNS operator*(BigRNS a, const BigRNS &b) {
+    a *= b;
+    return a;
+}
+
+BigRNS operator-(BigRNS a) {
+    a.negate();
+    return a;
+}
@@ -0,0 +1,145 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BigInteger.h"
+#include "BigIntegerThreadPool.h"
+
+using std::vector;
+
+
+// Integer kept as its residues modulo a basis of primes below 2^62. Addition, subtraction
+// and multiplication work on every residue by itself, with no carries between them, so long
+// chains of them cost a few word operations per prime and split across threads freely.
+// The value comes back through the Chinese remainder theorem, exactly as long as the true
+// result stays in [-M/2, M/2), M the product of the primes. A value keeps the thread pool it
+// was built with, which runs its conversions and the arithmetic on it; the pool outlives it.
+class BigRNS {
+
+public:
+
+    class Basis;
+
+    BigRNS(const BigInteger &, std::shared_ptr<const Basis>, BigIntegerThreadPool & = BigIntegerThreadPool::shared());
+
+    BigRNS(long, std::shared_ptr<const Basis>, BigIntegerThreadPool & = BigIntegerThreadPool::shared());
+
+    const std::shared_ptr<const Basis> &basis() const &{ return _basis; }
+
+    // residue i is modulo basis()->primes()[i]
+    const vector<uint64_t> &residues() const &{ return _residues; }
+
+    // of the left operand for results of binary operators
+    BigIntegerThreadPool &pool() const &{ return *_pool; }
+
+    BigRNS &negate() &;
+
+    BigRNS &operator+=(const BigRNS &) &;
+
+    BigRNS &operator-=(const BigRNS &) &;
+
+    BigRNS &operator*=(const BigRNS &) &;
+
+    // the value in [-M/2, M/2)
+    BigInteger to_big_integer() const &;
+
+    BigInteger to_big_integer(BigIntegerThreadPool &) const &;
+
+    friend bool operator==(const BigRNS &, const BigRNS &);
+
+private:
+
+    // from twice this many residues an operation is split into tasks of this many
+    static const size_t TASK_RESIDUES = 4096;
+
+    // below these many primes a part of a conversion is done by itself, not as a task
+    static const size_t TASK_PRIMES = 64;
+
+    // below these many primes the residues are taken a prime at a time
+    static const size_t LEAF_PRIMES = 16;
+
+    std::shared_ptr<const Basis> _basis;
+    vector<uint64_t> _residues;
+    BigIntegerThreadPool *_pool;
+
+    template<typename Operation>
+    BigRNS &apply(const BigRNS &, Operation);
+
+    void reduce(BigInteger magnitude, size_t node, size_t first, size_t last, BigIntegerThreadPool &);
+
+    BigInteger combine(const vector<uint64_t> &, size_t node, size_t first, size_t last,
+                       BigIntegerThreadPool &) const;
+};
+
+// The primes with what reduction modulo each of them and the CRT need, shared by all values
+// built on it.
+class BigRNS::Basis {
+
+public:
+
+    // the count largest primes below 2^62
+    explicit Basis(size_t count);
+
+    // the smallest basis of such primes holding every value of at most bits bits
+    static std::shared_ptr<const Basis> for_bits(unsigned int bits);
+
+    size_t size() const &{ return _primes.size(); }
+
+    const vector<uint64_t> &primes() const &{ return _primes; }
+
+    const BigInteger &modulus() const &{ return _tree[1]; }
+
+    // every value of at most this many bits besides the sign is represented exactly
+    unsigned int bits() const &{ return modulus().bit_length() - 2; }
+
+    // a b modulo prime i, for a and b below it
+    uint64_t multiply(uint64_t a, uint64_t b, size_t i) const &;
+
+private:
+
+    friend class BigRNS;
+
+    // division by a prime through its normalized reciprocal, as in BigIntegerKernels.h
+    struct Reducer {
+        int shift;
+        uint64_t normalized;
+        uint64_t inverse;
+    };
+
+    vector<uint64_t> _primes;
+    vector<Reducer> _reducers;
+    // (M / p_i)^-1 modulo p_i
+    vector<uint64_t> _crt;
+    // node 1 is M, the children of node k are 2 k and 2 k + 1 over the halves of its primes
+    vector<BigInteger> _tree;
+
+    void build(size_t node, size_t first, size_t last);
+
+    static Reducer reducer(uint64_t prime);
+
+    static uint64_t multiply(uint64_t a, uint64_t b, const Reducer &);
+
+    static uint64_t power(uint64_t a, uint64_t exponent, uint64_t prime, const Reducer &);
+
+    static bool is_prime(uint64_t);
+
+    // the count largest primes below 2^62, computed once and shared
+    static vector<uint64_t> largest_primes(size_t count);
+};
+
+
+BigRNS operator+(BigRNS, const BigRNS &);
+
+BigRNS operator-(BigRNS, const BigRNS &);
+
+BigRNS operator*(BigRNS, const BigRNS &);
+
+BigRNS operator-(BigRNS);
+
+bool operator!=(const BigRNS &, const BigRNS &);
@@ -0,0 +1,174 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+
+#include "BigRational.h"
+
+const int BigRational::REDUCE_SLACK;
+
+BigRational::BigRational(BigInteger numerator, BigInteger denominator) :
+        _numerator(std::move(numerator)),
+        _denominator(std::move(denominator)),
+        _reduced(false),
+        _reduced_size(0) {
+
+    if (_denominator == BigInteger::ZERO)
+        throw BigInteger::BigIntegerException("Zero denominator");
+
+    if (_denominator.is_neg()) {
+        _numerator.negate();
+        _denominator.negate();
+    }
+
+    _reduced = _denominator == BigInteger::ONE;
+    _reduced_size = _numerator.size() + _denominator.size();
+}
+
+BigRational::BigRational(const long number) :
+        BigRational(BigInteger(number)) {}
+
+BigRational &BigRational::reduce() &{
+
+    if (_reduced)
+        return *this;
+
+    const BigInteger divisor = gcd(_numerator, _denominator);
+    if (divisor != BigInteger::ONE) {
+        _numerator /= divisor;
+        _denominator /= divisor;
+    }
+    _reduced = true;
+    _reduced_size = _numerator.size() + _denominator.size();
+
+    return *this;
+}
+
+void BigRational::reduce_if_grown() {
+    if (!_reduced && _numerator.size() + _denominator.size() > 2 * _reduced_size + REDUCE_SLACK)
+        reduce();
+}
+
+BigRational &BigRational::negate() &{
+    _numerator.negate();
+    return *this;
+}
+
+string BigRational::to_string() const &{
+    BigRational lowest(*this);
+    lowest.reduce();
+    if (lowest._denominator == BigInteger::ONE)
+        return lowest._numerator.to_string();
+    return lowest._numerator.to_string() + "/" + lowest._denominator.to_string();
+}
+
+BigRational &BigRational::operator+=(const BigRational &b) &{
+
+    if (_denominator == b._denominator) {
+        _numerator += b._numerator;
+    } else {
+        _numerator *= b._denominator;
+        _numerator += b._numerator * _denominator;
+        _denominator *= b._denominator;
+    }
+
+    _reduced = _denominator == BigInteger::ONE;
+    reduce_if_grown();
+
+    return *this;
+}
+
+BigRational &BigRational::operator-=(const BigRational &b) &{
+    return (*this) += -b;
+}
+
+BigRational &BigRational::operator*=(const BigRational &b) &{
+
+    if (this == &b) {
+        _numerator *= _numerator;
+        _denominator *= _denominator;
+        reduce_if_grown();
+        return *this;
+    }
+
+    // (a / g1) (c / g2) / ((b / g2) (d / g1)) for a/b times c/d, g1 = gcd(a, d), g2 = gcd(c, b)
+    const BigInteger g1 = gcd(_numerator, b._denominator);
+    const BigInteger g2 = gcd(b._numerator, _denominator);
+
+    _numerator /= g1;
+    _numerator *= b._numerator / g2;
+    _denominator /= g2;
+    _denominator *= b._denominator / g1;
+
+    _reduced = _reduced && b._reduced;
+    reduce_if_grown();
+
+    return *this;
+}
+
+BigRational &BigRational::operator/=(const BigRational &b) &{
+
+    if (b._numerator == BigInteger::ZERO)
+        throw BigInteger::BigIntegerException("Division by zero");
+
+    BigRational reciprocal(b._denominator, b._numerator);
+    reciprocal._reduced = b._reduced;
+
+    return (*this) *= reciprocal;
+}
+
+int BigRational::compare(const BigRational &a, const BigRational &b) {
+    if (a._denominator == b._denominator)
+        return BigInteger::compare(a._numerator, b._numerator);
+    return BigInteger::compare(a._numerator * b._denominator, b._numerator * a._denominator);
+}
+
+ostream &operator<<(ostream &os, const BigRational &number) {
+    os << number.to_string();
+    return os;
+}
+
+BigRational operator+(BigRational a, const BigRational &b) {
+    return a += b;
+}
+
+BigRational operator-(BigRational a, const BigRational &b) {
+    return a -= b;
+}
+
+BigRational operator*(BigRational a, const BigRational &b) {
+    return a *= b;
+}
+
+BigRational operator/(BigRational a, const BigRational &b) {
+    return a /= b;
+}
+
+BigRational operator-(BigRational a) {
+    return a.negate();
+}
+
+bool operator==(const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) == 0;
+}
+
+bool operator!=(const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) != 0;
+}
+
+bool operator<=(const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) <= 0;
+}
+
+bool operator>=(const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) >= 0;
+}
+
+bool operator<(const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) < 0;
+}
+
+bool operator>(const BigRational &a, const BigRational &b) {
+    return BigRational::compare(a, b) > 0;
+}
@@ -0,0 +1,88 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include "BigInteger.h"
+
+using std::string;
+using std::ostream;
+
+
+// Exact fraction of two BigIntegers, the denominator always positive. Lowest terms are
+// kept lazily: multiplication cancels across the operands, which only takes gcds of the
+// smaller factors and keeps reduced operands reduced, while addition leaves the result
+// unreduced until the sizes grow past the last reduced size. Comparison is exact either way.
+class BigRational {
+
+public:
+
+    BigRational(BigInteger numerator = BigInteger::ZERO, BigInteger denominator = BigInteger::ONE);
+
+    BigRational(long);
+
+    // as stored, reduce() first for lowest terms
+    const BigInteger &numerator() const &{ return _numerator; }
+
+    const BigInteger &denominator() const &{ return _denominator; }
+
+    bool is_reduced() const &{ return _reduced; }
+
+    BigRational &reduce() &;
+
+    BigRational &negate() &;
+
+    // "numerator/denominator" in lowest terms, just "numerator" for integers
+    string to_string() const &;
+
+    BigRational &operator+=(const BigRational &) &;
+
+    BigRational &operator-=(const BigRational &) &;
+
+    BigRational &operator*=(const BigRational &) &;
+
+    BigRational &operator/=(const BigRational &) &;
+
+    static int compare(const BigRational &, const BigRational &);
+
+private:
+
+    // bytes an unreduced fraction may grow by past twice its last reduced size
+    static const int REDUCE_SLACK = 64;
+
+    BigInteger _numerator;
+    BigInteger _denominator;
+    bool _reduced;
+    int _reduced_size;
+
+    void reduce_if_grown();
+};
+
+
+ostream &operator<<(ostream &, const BigRational &);
+
+BigRational operator+(BigRational, const BigRational &);
+
+BigRational operator-(BigRational, const BigRational &);
+
+BigRational operator*(BigRational, const BigRational &);
+
+BigRational operator/(BigRational, const BigRational &);
+
+BigRational operator-(BigRational);
+
+bool operator==(const BigRational &, const BigRational &);
+
+bool operator!=(const BigRational &, const BigRational &);
+
+bool operator<=(const BigRational &, const BigRational &);
+
+bool operator>=(const BigRational &, const BigRational &);
+
+bool operator<(const BigRational &, const BigRational &);
+
+bool operator>(const BigRational &, const BigRational &);
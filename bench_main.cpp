@@ -0,0 +1,71 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "BigIntegerBenchmark.h"
+#include "BigIntegerStats.h"
+
+static void usage() {
+    std::cout << "Usage: BigInteger_bench [options]\n"
+                 "  --filter <operation>     parse, to_string, parse_parallel,\n"
+                 "                           to_string_parallel, add, sub, mul, div, shl, shr, compare,\n"
+                 "                           compare_shared, equal, hash, power\n"
+                 "  --min-bits <n>           smallest operand size (default 64)\n"
+                 "  --max-bits <n>           largest operand size (default 10000000)\n"
+                 "  --min-time-ms <ms>       minimal measuring time per size (default 100)\n"
+                 "  --budget-ms <ms>         stop growing an operation once one call exceeds it (default 2000)\n"
+                 "  --seed <n>               operand generator seed (default 12345)\n"
+                 "  --json <file>            write results as JSON\n"
+                 "  --baseline <file>        compare with a JSON file written by --json\n"
+                 "  --threshold <fraction>   allowed slowdown against baseline (default 0.10)\n";
+}
+
+int main(int argc, char **argv) {
+
+    BigIntegerBenchmark::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0) {
+            usage();
+            return 0;
+        }
+        if (value == nullptr) {
+            usage();
+            return 2;
+        }
+
+        if (std::strcmp(arg, "--filter") == 0) options.filter = value;
+        else if (std::strcmp(arg, "--min-bits") == 0) options.min_bits = std::atoi(value);
+        else if (std::strcmp(arg, "--max-bits") == 0) options.max_bits = std::atoi(value);
+        else if (std::strcmp(arg, "--min-time-ms") == 0) options.min_time_ms = std::atof(value);
+        else if (std::strcmp(arg, "--budget-ms") == 0) options.budget_ms = std::atof(value);
+        else if (std::strcmp(arg, "--seed") == 0) options.seed = static_cast<unsigned int>(std::atol(value));
+        else if (std::strcmp(arg, "--json") == 0) options.json_path = value;
+        else if (std::strcmp(arg, "--baseline") == 0) options.baseline_path = value;
+        else if (std::strcmp(arg, "--threshold") == 0) options.threshold = std::atof(value);
+        else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    if (options.min_bits < 2 || options.max_bits < options.min_bits) {
+        usage();
+        return 2;
+    }
+
+    int status = BigIntegerBenchmark::run(options);
+
+    if (BigIntegerStats::enabled())
+        std::cout << "\n" << BigIntegerStats::snapshot().to_text();
+
+    return status;
+}
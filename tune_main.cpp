@@ -0,0 +1,193 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BigInteger.h"
+#include "BigIntegerConversion.h"
+#include "BigIntegerKernels.h"
+#include "BigIntegerRandom.h"
+#include "BigIntegerThresholds.h"
+
+using std::vector;
+using Threshold = BigIntegerThresholds::Threshold;
+
+static double min_time_ms = 20;
+
+static void usage() {
+    std::cout << "Usage: BigInteger_tune [options]\n"
+                 "  --config <file>          write the thresholds for the BIGINTEGER_TUNING environment variable\n"
+                 "  --header <file>          write the thresholds for the BIGINTEGER_TUNING_HEADER CMake option\n"
+                 "  --min-time-ms <ms>       measuring time per size and variant (default 20)\n";
+}
+
+// the fastest of three runs, in nanoseconds per call
+static double measure(const std::function<void()> &operation) {
+    double best = 0;
+    for (int run = 0; run < 3; run++) {
+        long iterations = 0;
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            operation();
+            iterations++;
+            elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < min_time_ms / 3);
+        const double per_call = elapsed * 1e6 / static_cast<double>(iterations);
+        if (run == 0 || per_call < best)
+            best = per_call;
+    }
+    return best;
+}
+
+// the smallest size from which the faster tier wins at it and at the two sizes after it;
+// tiers(size, true) runs the upper tier once, tiers(size, false) the lower one
+static size_t crossover(const char *what, const vector<size_t> &sizes,
+                        const std::function<void(size_t, bool)> &tiers) {
+    std::cout << what << "\n";
+    vector<bool> wins;
+    for (size_t size : sizes) {
+        const double lower = measure([&tiers, size]() { tiers(size, false); });
+        const double upper = measure([&tiers, size]() { tiers(size, true); });
+        std::cout << "  " << size << ": " << lower << " ns against " << upper << " ns\n";
+        wins.push_back(upper < lower);
+    }
+    for (size_t i = 0; i < sizes.size(); i++) {
+        bool stable = true;
+        for (size_t j = i; j < std::min(i + 3, sizes.size()); j++)
+            stable = stable && wins[j];
+        if (stable)
+            return sizes[i];
+    }
+    return sizes.back() * 2;
+}
+
+static vector<size_t> geometric(size_t first, const size_t last) {
+    vector<size_t> sizes;
+    for (; first <= last; first = std::max(first + 1, first * 9 / 8))
+        sizes.push_back(first);
+    return sizes;
+}
+
+static vector<mpn::limb> random_limbs(std::mt19937_64 &generator, const size_t count) {
+    vector<mpn::limb> limbs(count);
+    for (mpn::limb &limb : limbs)
+        limb = generator();
+    return limbs;
+}
+
+static BigInteger random_number(std::mt19937_64 &generator, const size_t words) {
+    BigInteger number = BigIntegerRandom::random_bits(static_cast<unsigned int>(64 * words), generator);
+    number.set_bit(static_cast<unsigned int>(64 * words));
+    return number;
+}
+
+int main(int argc, char **argv) {
+
+    const char *config_path = nullptr;
+    const char *header_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0) {
+            usage();
+            return 0;
+        }
+        if (value == nullptr) {
+            usage();
+            return 2;
+        }
+
+        if (std::strcmp(arg, "--config") == 0) config_path = value;
+        else if (std::strcmp(arg, "--header") == 0) header_path = value;
+        else if (std::strcmp(arg, "--min-time-ms") == 0) min_time_ms = std::atof(value);
+        else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    std::mt19937_64 generator(41);
+    const size_t NEVER = static_cast<size_t>(1) << 40;
+    vector<size_t> tuned(BigIntegerThresholds::COUNT);
+
+    // one level of Karatsuba over the schoolbook halves against the schoolbook product
+    const vector<mpn::limb> a = random_limbs(generator, 512), b = random_limbs(generator, 512);
+    vector<mpn::limb> product(1024), scratch(mpn::mul_scratch_size(512));
+    tuned[BigIntegerThresholds::MUL_KARATSUBA] = crossover("mul_karatsuba (limbs)", geometric(8, 160),
+            [&](const size_t n, const bool upper) {
+                BigIntegerThresholds::set(BigIntegerThresholds::MUL_KARATSUBA, upper ? (n + 1) / 2 + 1 : NEVER);
+                mpn::mul(product.data(), a.data(), n, b.data(), n, scratch.data());
+            });
+    tuned[BigIntegerThresholds::SQR_KARATSUBA] = crossover("sqr_karatsuba (limbs)", geometric(8, 240),
+            [&](const size_t n, const bool upper) {
+                BigIntegerThresholds::set(BigIntegerThresholds::SQR_KARATSUBA, upper ? (n + 1) / 2 + 1 : NEVER);
+                mpn::sqr(product.data(), a.data(), n, scratch.data());
+            });
+    BigIntegerThresholds::set(BigIntegerThresholds::MUL_KARATSUBA, tuned[BigIntegerThresholds::MUL_KARATSUBA]);
+    BigIntegerThresholds::set(BigIntegerThresholds::SQR_KARATSUBA, tuned[BigIntegerThresholds::SQR_KARATSUBA]);
+
+    // words against bytes, on operands of opposite signs so that the carry runs through
+    vector<BigInteger> addends, negative_addends;
+    for (size_t words = 0; words <= 24; words++) {
+        addends.push_back(random_number(generator, words));
+        negative_addends.push_back(-random_number(generator, words));
+    }
+    tuned[BigIntegerThresholds::ADD_LIMBS] = crossover("add_limbs (words)", geometric(1, 24),
+            [&](const size_t words, const bool upper) {
+                BigIntegerThresholds::set(BigIntegerThresholds::ADD_LIMBS, upper ? 1 : NEVER);
+                BigInteger sum(addends[words]);
+                sum += negative_addends[words];
+            });
+    BigIntegerThresholds::set(BigIntegerThresholds::ADD_LIMBS, tuned[BigIntegerThresholds::ADD_LIMBS]);
+
+    // the leaf size converting a large value the fastest, on a single thread
+    std::cout << "conversion_leaf (bytes)\n";
+    BigIntegerThreadPool pool(0);
+    const BigInteger value = random_number(generator, 4096);
+    double best = 0;
+    for (size_t leaf = 32; leaf <= 4096; leaf *= 2) {
+        BigIntegerThresholds::set(BigIntegerThresholds::CONVERSION_LEAF, leaf);
+        const double time = measure([&value, &pool]() { BigIntegerConversion::to_string(value, pool); });
+        std::cout << "  " << leaf << ": " << time << " ns\n";
+        if (leaf == 32 || time < best) {
+            best = time;
+            tuned[BigIntegerThresholds::CONVERSION_LEAF] = leaf;
+        }
+    }
+
+    for (int i = 0; i < BigIntegerThresholds::COUNT; i++)
+        BigIntegerThresholds::set(static_cast<Threshold>(i), tuned[i]);
+
+    std::cout << "\n" << BigIntegerThresholds::config();
+
+    if (config_path != nullptr) {
+        std::ofstream file(config_path);
+        file << "# Generated by BigInteger_tune\n" << BigIntegerThresholds::config();
+        if (!file) {
+            std::cerr << "Cannot write " << config_path << "\n";
+            return 1;
+        }
+    }
+    if (header_path != nullptr) {
+        std::ofstream file(header_path);
+        file << BigIntegerThresholds::header();
+        if (!file) {
+            std::cerr << "Cannot write " << header_path << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
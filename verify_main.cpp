@@ -0,0 +1,28 @@
+//*******************************************//
+//       Developed by Oleksandr Hrytsiuk     //
+//                  Project                  //
+//*******************************************//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "BigIntegerTester.h"
+
+int main(int argc, char **argv) {
+
+    unsigned int seed = 20200101;
+    int rounds = 200;
+    int max_bytes = 24;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned int>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--rounds") == 0) rounds = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--max-bytes") == 0) max_bytes = std::atoi(argv[i + 1]);
+        else {
+            std::cout << "Usage: BigInteger_verify [--seed <n>] [--rounds <n>] [--max-bytes <n>]\n";
+            return 2;
+        }
+    }
+
+    return BigIntegerTester::test_cross_check(seed, rounds, max_bytes) == 0 ? 0 : 1;
+}